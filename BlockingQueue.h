@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+#include "ConcurrentQueue.h"
+
+// ConcurrentQueue    .
+//    ,   :    
+//          .
+
+template <typename _Ty, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Elements<64>>
+class BlockingQueue
+{
+private:
+	using _Queue = ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>;
+
+	_Queue _queue;
+
+	alignas(64) std::atomic<std::size_t> _waiters{ 0 };
+	std::mutex _mutex;
+	std::condition_variable _ready;
+
+	//      ,  try_take   
+	class Waiter_Guard
+	{
+	public:
+		explicit Waiter_Guard(std::atomic<std::size_t>& waiters) : _waiters(waiters) { _waiters.fetch_add(1, std::memory_order_seq_cst); }
+		Waiter_Guard(const Waiter_Guard&) = delete;
+		Waiter_Guard& operator=(const Waiter_Guard&) = delete;
+		~Waiter_Guard() { _waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+	private:
+		std::atomic<std::size_t>& _waiters;
+	};
+
+	void wake(std::size_t count);
+
+	template<typename _Pred>
+	bool wait_until(std::chrono::steady_clock::time_point deadline, _Pred&& try_take);
+
+public:
+	using value_type = _Ty;
+	using allocator_type = _Alloc;
+	using size_type = std::size_t;
+
+	BlockingQueue() = default;
+	explicit BlockingQueue(const allocator_type& alloc);
+	BlockingQueue(const BlockingQueue&) = delete;
+	BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+	allocator_type get_allocator() const noexcept;
+
+	void push_back_notify(const _Ty& value);
+	void push_back_notify(_Ty&& value);
+	//         
+	template <std::input_iterator _InIt>
+	void push_back_bulk_notify(_InIt first, size_type count);
+
+	bool try_pop_front(_Ty& out);
+	void pop_front_wait(_Ty& out);
+	template<typename _Rep, typename _Period>
+	bool pop_front_wait(_Ty& out, const std::chrono::duration<_Rep, _Period>& timeout);
+
+	//     ,    ,    max_count
+	template<typename _OutIt, typename _Rep, typename _Period>
+	size_type pop_front_bulk_wait(_OutIt dest, size_type max_count, const std::chrono::duration<_Rep, _Period>& timeout);
+
+	//   ;    
+	void notify_all();
+
+	//    
+	bool empty() const noexcept;
+	size_type waiters() const noexcept;
+};
+
+// IMPLEMENTATION
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline BlockingQueue<_Ty, _Alloc, _BlockPolicy>::BlockingQueue(const allocator_type& alloc)
+	: _queue(alloc)
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline typename BlockingQueue<_Ty, _Alloc, _BlockPolicy>::allocator_type BlockingQueue<_Ty, _Alloc, _BlockPolicy>::get_allocator() const noexcept
+{
+	return _queue.get_allocator();
+}
+
+// fence    fence  fetch_add  wait_until:   
+// ,       
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::wake(std::size_t count)
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::size_t waiters = _waiters.load(std::memory_order_relaxed);
+	if (waiters == 0)
+		return;
+
+	//  ,        
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	//    ,   
+	if (count >= waiters)
+		_ready.notify_all();
+	else
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			_ready.notify_one();
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename _Pred>
+bool BlockingQueue<_Ty, _Alloc, _BlockPolicy>::wait_until(std::chrono::steady_clock::time_point deadline, _Pred&& try_take)
+{
+	if (try_take())
+		return true;
+
+	Waiter_Guard waiter(_waiters);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	//   ,     
+	std::unique_lock<std::mutex> lock(_mutex);
+	bool taken = false;
+	while (!(taken = try_take()))
+	{
+		if (deadline == std::chrono::steady_clock::time_point::max())
+			_ready.wait(lock);
+		else if (_ready.wait_until(lock, deadline) == std::cv_status::timeout)
+		{
+			taken = try_take();
+			break;
+		}
+	}
+	return taken;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::push_back_notify(const _Ty& value)
+{
+	_queue.try_push(value);
+	wake(1);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::push_back_notify(_Ty&& value)
+{
+	_queue.try_push(std::move(value));
+	wake(1);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template <std::input_iterator _InIt>
+inline void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::push_back_bulk_notify(_InIt first, size_type count)
+{
+	if (count == 0)
+		return;
+
+	_queue.try_push_bulk(first, count);
+	wake(count);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool BlockingQueue<_Ty, _Alloc, _BlockPolicy>::try_pop_front(_Ty& out)
+{
+	return _queue.try_pop(out);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::pop_front_wait(_Ty& out)
+{
+	wait_until(std::chrono::steady_clock::time_point::max(), [&] { return _queue.try_pop(out); });
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename _Rep, typename _Period>
+bool BlockingQueue<_Ty, _Alloc, _BlockPolicy>::pop_front_wait(_Ty& out, const std::chrono::duration<_Rep, _Period>& timeout)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+	return wait_until(deadline, [&] { return _queue.try_pop(out); });
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename _OutIt, typename _Rep, typename _Period>
+typename BlockingQueue<_Ty, _Alloc, _BlockPolicy>::size_type BlockingQueue<_Ty, _Alloc, _BlockPolicy>::pop_front_bulk_wait(_OutIt dest, size_type max_count, const std::chrono::duration<_Rep, _Period>& timeout)
+{
+	if (max_count == 0)
+		return 0;
+
+	size_type taken = 0;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+	wait_until(deadline, [&] { return (taken = _queue.try_pop_bulk(dest, max_count)) != 0; });
+	return taken;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void BlockingQueue<_Ty, _Alloc, _BlockPolicy>::notify_all()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	_ready.notify_all();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool BlockingQueue<_Ty, _Alloc, _BlockPolicy>::empty() const noexcept
+{
+	return _queue.empty();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline typename BlockingQueue<_Ty, _Alloc, _BlockPolicy>::size_type BlockingQueue<_Ty, _Alloc, _BlockPolicy>::waiters() const noexcept
+{
+	return _waiters.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,1172 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+#include <bit>
+#include <compare>
+#include <algorithm>
+#include <initializer_list>
+
+#include "Deque.h"
+
+//   :     ,
+//   -  (_head + index) & MASK,    .
+//  ,       .
+
+//  std::length_error; try_push_*  false
+struct Bounded_Overflow_Reject {};
+
+//     
+struct Bounded_Overflow_Overwrite {};
+
+//     Deque     ;
+//   ,   
+struct Bounded_Overflow_Grow {};
+
+//     : Reject , Grow   Deque,
+// Overwrite   ,  push_back. ,  
+// , Reject  ,  Overwrite   .
+// resize    std::length_error  Reject  Overwrite.
+
+template <typename _Ty, std::size_t _Capacity, typename _Overflow = Bounded_Overflow_Reject, typename _Alloc = std::allocator<_Ty>>
+class BoundedDeque
+{
+private:
+	static constexpr std::size_t CAPACITY = _Capacity;
+	static constexpr std::size_t MASK = CAPACITY - 1;
+	static constexpr bool GROW = std::is_same_v<_Overflow, Bounded_Overflow_Grow>;
+	static constexpr bool OVERWRITE = std::is_same_v<_Overflow, Bounded_Overflow_Overwrite>;
+
+	static_assert(std::has_single_bit(CAPACITY), "capacity must be a power of two");
+	static_assert(GROW || OVERWRITE || std::is_same_v<_Overflow, Bounded_Overflow_Reject>,
+		"unknown overflow policy");
+
+	using _Alty = typename std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+	using _Alty_traits = std::allocator_traits<_Alty>;
+
+	struct No_Spill {};
+	using Spill = std::conditional_t<GROW, Deque<_Ty, _Alloc>, No_Spill>;
+
+	//  ,     
+	static constexpr bool NOTHROW_MOVE = std::is_nothrow_move_constructible_v<_Ty>
+		&& std::is_nothrow_move_assignable_v<Spill>;
+
+	alignas(_Ty) unsigned char _storage[sizeof(_Ty) * CAPACITY];
+	std::size_t _head = 0;
+	std::size_t _size = 0;
+	[[no_unique_address]] _Alty _alloc;
+
+	[[no_unique_address]] Spill _spill;
+	bool _spilled = false;
+
+	_Ty* slot(std::size_t position) noexcept;
+	const _Ty* slot(std::size_t position) const noexcept;
+
+	static Spill make_spill(const _Alloc& alloc);
+	bool is_spilled() const noexcept;
+	void spill();
+	void destroy_ring() noexcept;
+
+	//    ;    
+	template <typename _It>
+	std::size_t insert_range(std::size_t index, _It first, _It last, std::size_t count);
+
+	template <typename... Args>
+	_Ty& overwrite_back(Args&&... args);
+	template <typename... Args>
+	_Ty& overwrite_front(Args&&... args);
+
+public:
+	using value_type = _Ty;
+	using allocator_type = _Alloc;
+	using pointer = _Ty*;
+	using const_pointer = const _Ty*;
+	using reference = _Ty&;
+	using const_reference = const _Ty&;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	//    :      
+	template <typename _Elem, typename _Owner>
+	class Ring_Iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = _Ty;
+		using difference_type = std::ptrdiff_t;
+		using pointer = _Elem*;
+		using reference = _Elem&;
+
+		Ring_Iterator() noexcept = default;
+		template <typename _Other, typename _OtherOwner>
+			requires std::is_convertible_v<_Other*, _Elem*>
+		Ring_Iterator(const Ring_Iterator<_Other, _OtherOwner>& other) noexcept;
+
+		reference operator*() const;
+		pointer operator->() const;
+		reference operator[](difference_type n) const;
+
+		Ring_Iterator& operator++();
+		Ring_Iterator operator++(int);
+		Ring_Iterator& operator--();
+		Ring_Iterator operator--(int);
+
+		Ring_Iterator& operator+=(difference_type n);
+		Ring_Iterator& operator-=(difference_type n);
+		Ring_Iterator operator+(difference_type n) const;
+		Ring_Iterator operator-(difference_type n) const;
+		friend Ring_Iterator operator+(difference_type n, const Ring_Iterator& it) { return it + n; }
+
+		difference_type operator-(const Ring_Iterator& rhs) const;
+
+		bool operator==(const Ring_Iterator& rhs) const;
+		std::strong_ordering operator<=>(const Ring_Iterator& rhs) const;
+
+	private:
+		Ring_Iterator(_Owner* owner, size_type index) noexcept;
+
+		_Owner* _owner = nullptr;
+		size_type _index = 0;
+
+		friend class BoundedDeque;
+		template <typename, typename>
+		friend class Ring_Iterator;
+	};
+
+	using iterator = Ring_Iterator<_Ty, BoundedDeque>;
+	using const_iterator = Ring_Iterator<const _Ty, const BoundedDeque>;
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	BoundedDeque() noexcept(noexcept(allocator_type()));
+	explicit BoundedDeque(const allocator_type& alloc);
+	BoundedDeque(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type());
+	BoundedDeque(const BoundedDeque& other);
+	BoundedDeque(BoundedDeque&& other) noexcept(NOTHROW_MOVE);
+	~BoundedDeque();
+
+	BoundedDeque& operator=(const BoundedDeque& other);
+	BoundedDeque& operator=(BoundedDeque&& other) noexcept(NOTHROW_MOVE);
+
+	allocator_type get_allocator() const noexcept;
+
+	void assign(std::initializer_list<value_type> init);
+	void assign(size_type count, const_reference value);
+
+	void push_back(const_reference value);
+	void push_back(value_type&& value);
+	void push_front(const_reference value);
+	void push_front(value_type&& value);
+
+	template <typename... Args>
+	reference emplace_back(Args&&... args);
+	template <typename... Args>
+	reference emplace_front(Args&&... args);
+
+	template <typename... Args>
+	iterator emplace(iterator pos, Args&&... args);
+
+	// false,   ,   
+	bool try_push_back(const_reference value);
+	bool try_push_back(value_type&& value);
+	bool try_push_front(const_reference value);
+	bool try_push_front(value_type&& value);
+
+	void pop_back();
+	void pop_front();
+	void unchecked_pop_back() noexcept;
+	void unchecked_pop_front() noexcept;
+
+	reference front();
+	const_reference front() const;
+	reference back();
+	const_reference back() const;
+
+	reference operator[](size_type index);
+	const_reference operator[](size_type index) const;
+	reference at(size_type index);
+	const_reference at(size_type index) const;
+
+	void clear() noexcept;
+
+	size_type size() const noexcept;
+	bool empty() const noexcept;
+	bool full() const noexcept;
+	size_type capacity() const noexcept;
+	static constexpr size_type max_inline_size() noexcept;
+
+	//  Bounded_Overflow_Grow:     Deque
+	bool spilled() const noexcept;
+
+	void resize(size_type new_size);
+	void resize(size_type new_size, const_reference value);
+
+	void swap(BoundedDeque& other);
+
+	iterator insert(iterator pos, const_reference value);
+	iterator insert(iterator pos, value_type&& value);
+	template <std::input_iterator _InIt>
+	iterator insert(iterator pos, _InIt first, _InIt last);
+	iterator erase(iterator pos);
+	iterator erase(iterator first, iterator last);
+
+	iterator begin() noexcept;
+	iterator end() noexcept;
+	const_iterator begin() const noexcept;
+	const_iterator end() const noexcept;
+	const_iterator cbegin() const noexcept;
+	const_iterator cend() const noexcept;
+
+	reverse_iterator rbegin() noexcept;
+	reverse_iterator rend() noexcept;
+	const_reverse_iterator rbegin() const noexcept;
+	const_reverse_iterator rend() const noexcept;
+
+	bool operator==(const BoundedDeque& other) const;
+	bool operator!=(const BoundedDeque& other) const;
+};
+
+// IMPLEMENTATION
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::Ring_Iterator(_Owner* owner, size_type index) noexcept
+	: _owner(owner), _index(index)
+{
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+template<typename _Other, typename _OtherOwner>
+	requires std::is_convertible_v<_Other*, _Elem*>
+inline BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::Ring_Iterator(const Ring_Iterator<_Other, _OtherOwner>& other) noexcept
+	: _owner(other._owner), _index(other._index)
+{
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator*() const
+{
+	return (*_owner)[_index];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::pointer BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator->() const
+{
+	return &(*_owner)[_index];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator[](difference_type n) const
+{
+	return (*_owner)[_index + n];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator++()
+{
+	++_index;
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner> BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator++(int)
+{
+	Ring_Iterator tmp = *this;
+	++_index;
+	return tmp;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator--()
+{
+	--_index;
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner> BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator--(int)
+{
+	Ring_Iterator tmp = *this;
+	--_index;
+	return tmp;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator+=(difference_type n)
+{
+	_index += n;
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator-=(difference_type n)
+{
+	_index -= n;
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner> BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator+(difference_type n) const
+{
+	return Ring_Iterator(_owner, _index + n);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner> BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator-(difference_type n) const
+{
+	return Ring_Iterator(_owner, _index - n);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::difference_type BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator-(const Ring_Iterator& rhs) const
+{
+	return static_cast<difference_type>(_index) - static_cast<difference_type>(rhs._index);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator==(const Ring_Iterator& rhs) const
+{
+	return _index == rhs._index;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename _Elem, typename _Owner>
+inline std::strong_ordering BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Ring_Iterator<_Elem, _Owner>::operator<=>(const Ring_Iterator& rhs) const
+{
+	return _index <=> rhs._index;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline _Ty* BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::slot(std::size_t position) noexcept
+{
+	return reinterpret_cast<_Ty*>(_storage) + (position & MASK);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline const _Ty* BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::slot(std::size_t position) const noexcept
+{
+	return reinterpret_cast<const _Ty*>(_storage) + (position & MASK);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::Spill BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::make_spill(const _Alloc& alloc)
+{
+	if constexpr (GROW)
+		return Spill(alloc);
+	else
+		return Spill{};
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::is_spilled() const noexcept
+{
+	if constexpr (GROW)
+		return _spilled;
+	else
+		return false;
+}
+
+//  :    Deque,    
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::spill()
+{
+	if constexpr (GROW)
+	{
+		//     (move_if_noexcept),   ,
+		//        
+		try
+		{
+			_spill.reserve_back(2 * CAPACITY);
+			for (size_type i = 0; i < _size; ++i)
+				_spill.push_back(std::move_if_noexcept(*slot(_head + i)));
+		}
+		catch (...)
+		{
+			_spill.clear();
+			throw;
+		}
+
+		destroy_ring();
+		_spilled = true;
+	}
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::destroy_ring() noexcept
+{
+	if constexpr (!std::is_trivially_destructible_v<_Ty>)
+	{
+		for (size_type i = 0; i < _size; ++i)
+			_Alty_traits::destroy(_alloc, slot(_head + i));
+	}
+	_head = 0;
+	_size = 0;
+}
+
+//        :
+//      
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename ...Args>
+_Ty& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::overwrite_back(Args&&... args)
+{
+	_Ty* target = slot(_head);
+	*target = _Ty(std::forward<Args>(args)...);
+	_head = (_head + 1) & MASK;
+	return *target;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename ...Args>
+_Ty& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::overwrite_front(Args&&... args)
+{
+	_Ty* target = slot(_head + MASK);
+	*target = _Ty(std::forward<Args>(args)...);
+	_head = (_head + MASK) & MASK;
+	return *target;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::BoundedDeque() noexcept(noexcept(allocator_type()))
+	: _alloc()
+{
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::BoundedDeque(const allocator_type& alloc)
+	: _alloc(alloc), _spill(make_spill(alloc))
+{
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::BoundedDeque(std::initializer_list<value_type> init, const allocator_type& alloc)
+	: BoundedDeque(alloc)
+{
+	for (const _Ty& value : init)
+		push_back(value);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::BoundedDeque(const BoundedDeque& other)
+	: BoundedDeque(_Alty_traits::select_on_container_copy_construction(other._alloc))
+{
+	if (other.is_spilled())
+	{
+		if constexpr (GROW)
+		{
+			_spill = other._spill;
+			_spilled = true;
+		}
+		return;
+	}
+
+	for (size_type i = 0; i < other._size; ++i)
+		emplace_back(*other.slot(other._head + i));
+}
+
+//    ,    
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::BoundedDeque(BoundedDeque&& other) noexcept(NOTHROW_MOVE)
+	: BoundedDeque(allocator_type(other._alloc))
+{
+	if (other.is_spilled())
+	{
+		if constexpr (GROW)
+		{
+			_spill = std::move(other._spill);
+			_spilled = true;
+			other._spill.clear();
+			other._spilled = false;
+		}
+		return;
+	}
+
+	for (size_type i = 0; i < other._size; ++i)
+		emplace_back(std::move(*other.slot(other._head + i)));
+	other.clear();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::~BoundedDeque()
+{
+	destroy_ring();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator=(const BoundedDeque& other)
+{
+	if (this != &other)
+	{
+		clear();
+		for (const _Ty& value : other)
+			push_back(value);
+	}
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>& BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator=(BoundedDeque&& other) noexcept(NOTHROW_MOVE)
+{
+	if (this != &other)
+	{
+		clear();
+		if (other.is_spilled())
+		{
+			if constexpr (GROW)
+			{
+				_spill = std::move(other._spill);
+				_spilled = true;
+				other._spill.clear();
+				other._spilled = false;
+			}
+			return *this;
+		}
+
+		for (size_type i = 0; i < other._size; ++i)
+			emplace_back(std::move(*other.slot(other._head + i)));
+		other.clear();
+	}
+	return *this;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::allocator_type BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::get_allocator() const noexcept
+{
+	return allocator_type(_alloc);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::assign(std::initializer_list<value_type> init)
+{
+	clear();
+	for (const _Ty& value : init)
+		push_back(value);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::assign(size_type count, const_reference value)
+{
+	if constexpr (!GROW)
+	{
+		if (count > CAPACITY)
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	// value      
+	_Ty copy(value);
+	clear();
+	for (size_type i = 0; i < count; ++i)
+		push_back(copy);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::push_back(const_reference value)
+{
+	emplace_back(value);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::push_back(value_type&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::push_front(const_reference value)
+{
+	emplace_front(value);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::push_front(value_type&& value)
+{
+	emplace_front(std::move(value));
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename ...Args>
+typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::emplace_back(Args&&... args)
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill.emplace_back(std::forward<Args>(args)...);
+	}
+
+	if (_size == CAPACITY)
+	{
+		if constexpr (OVERWRITE)
+			return overwrite_back(std::forward<Args>(args)...);
+		else if constexpr (GROW)
+		{
+			//      
+			_Ty value(std::forward<Args>(args)...);
+			spill();
+			return _spill.emplace_back(std::move(value));
+		}
+		else
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	_Ty* target = slot(_head + _size);
+	_Alty_traits::construct(_alloc, target, std::forward<Args>(args)...);
+	++_size;
+	return *target;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename ...Args>
+typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::emplace_front(Args&&... args)
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill.emplace_front(std::forward<Args>(args)...);
+	}
+
+	if (_size == CAPACITY)
+	{
+		if constexpr (OVERWRITE)
+			return overwrite_front(std::forward<Args>(args)...);
+		else if constexpr (GROW)
+		{
+			_Ty value(std::forward<Args>(args)...);
+			spill();
+			return _spill.emplace_front(std::move(value));
+		}
+		else
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	_Ty* target = slot(_head + MASK);
+	_Alty_traits::construct(_alloc, target, std::forward<Args>(args)...);
+	_head = (_head + MASK) & MASK;
+	++_size;
+	return *target;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template<typename ...Args>
+typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::emplace(iterator pos, Args&&... args)
+{
+	size_type index = pos._index;
+
+	if constexpr (GROW)
+	{
+		if (_spilled)
+		{
+			_spill.emplace(_spill.begin() + index, std::forward<Args>(args)...);
+			return iterator(this, index);
+		}
+	}
+
+	//      
+	_Ty value(std::forward<Args>(args)...);
+
+	if (_size == CAPACITY)
+	{
+		if constexpr (GROW)
+		{
+			spill();
+			_spill.emplace(_spill.begin() + index, std::move(value));
+			return iterator(this, index);
+		}
+		else if constexpr (OVERWRITE)
+		{
+			unchecked_pop_front();
+			if (index > 0)
+				--index;
+		}
+		else
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	//          
+	if (index < _size / 2)
+	{
+		emplace_front(std::move(value));
+		std::rotate(begin(), begin() + 1, begin() + index + 1);
+	}
+	else
+	{
+		emplace_back(std::move(value));
+		std::rotate(begin() + index, end() - 1, end());
+	}
+	return iterator(this, index);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::try_push_back(const_reference value)
+{
+	if (full())
+		return false;
+	emplace_back(value);
+	return true;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::try_push_back(value_type&& value)
+{
+	if (full())
+		return false;
+	emplace_back(std::move(value));
+	return true;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::try_push_front(const_reference value)
+{
+	if (full())
+		return false;
+	emplace_front(value);
+	return true;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::try_push_front(value_type&& value)
+{
+	if (full())
+		return false;
+	emplace_front(std::move(value));
+	return true;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::pop_back()
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+
+	unchecked_pop_back();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::pop_front()
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+
+	unchecked_pop_front();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::unchecked_pop_back() noexcept
+{
+	assert(!empty());
+
+	if constexpr (GROW)
+	{
+		if (_spilled)
+		{
+			_spill.unchecked_pop_back();
+			_spilled = !_spill.empty();
+			return;
+		}
+	}
+
+	--_size;
+	_Alty_traits::destroy(_alloc, slot(_head + _size));
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::unchecked_pop_front() noexcept
+{
+	assert(!empty());
+
+	if constexpr (GROW)
+	{
+		if (_spilled)
+		{
+			_spill.unchecked_pop_front();
+			_spilled = !_spill.empty();
+			return;
+		}
+	}
+
+	_Alty_traits::destroy(_alloc, slot(_head));
+	_head = (_head + 1) & MASK;
+	--_size;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::front()
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+	return (*this)[0];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::front() const
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+	return (*this)[0];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::back()
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+	return (*this)[size() - 1];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::back() const
+{
+	if (empty())
+		throw std::out_of_range("BoundedDeque is empty!");
+	return (*this)[size() - 1];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator[](size_type index)
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill[index];
+	}
+	return *slot(_head + index);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator[](size_type index) const
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill[index];
+	}
+	return *slot(_head + index);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::at(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index out of range!");
+	return (*this)[index];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reference BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::at(size_type index) const
+{
+	if (index >= size())
+		throw std::out_of_range("Index out of range!");
+	return (*this)[index];
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::clear() noexcept
+{
+	if constexpr (GROW)
+	{
+		_spill.clear();
+		_spilled = false;
+	}
+	destroy_ring();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::size_type BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::size() const noexcept
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill.size();
+	}
+	return _size;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::full() const noexcept
+{
+	return is_spilled() || _size == CAPACITY;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::size_type BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::capacity() const noexcept
+{
+	if constexpr (GROW)
+	{
+		if (_spilled)
+			return _spill.capacity();
+	}
+	return CAPACITY;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+constexpr typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::size_type BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::max_inline_size() noexcept
+{
+	return CAPACITY;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::spilled() const noexcept
+{
+	return is_spilled();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::resize(size_type new_size)
+{
+	if constexpr (!GROW)
+	{
+		if (new_size > CAPACITY)
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	while (size() > new_size)
+		unchecked_pop_back();
+	while (size() < new_size)
+		emplace_back();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::resize(size_type new_size, const_reference value)
+{
+	if constexpr (!GROW)
+	{
+		if (new_size > CAPACITY)
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	while (size() > new_size)
+		unchecked_pop_back();
+	if (size() < new_size)
+	{
+		_Ty copy(value);
+		while (size() < new_size)
+			push_back(copy);
+	}
+}
+
+//    ,   -   
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+void BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::swap(BoundedDeque& other)
+{
+	if (this == &other)
+		return;
+
+	BoundedDeque tmp(std::move(other));
+	other = std::move(*this);
+	*this = std::move(tmp);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::insert(iterator pos, const_reference value)
+{
+	return emplace(pos, value);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::insert(iterator pos, value_type&& value)
+{
+	return emplace(pos, std::move(value));
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template <std::input_iterator _InIt>
+typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::insert(iterator pos, _InIt first, _InIt last)
+{
+	if constexpr (std::forward_iterator<_InIt>)
+		return iterator(this, insert_range(pos._index, first, last, static_cast<size_type>(std::distance(first, last))));
+	else
+	{
+		//      :   
+		Deque<_Ty, _Alloc> buffer{ allocator_type(_alloc) };
+		buffer.append(first, last);
+		return iterator(this, insert_range(pos._index, std::make_move_iterator(buffer.begin()), std::make_move_iterator(buffer.end()), buffer.size()));
+	}
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+template <typename _It>
+std::size_t BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::insert_range(std::size_t index, _It first, _It last, std::size_t count)
+{
+	if constexpr (GROW)
+	{
+		if (_spilled || _size + count > CAPACITY)
+		{
+			if (!_spilled)
+				spill();
+			_spill.insert(_spill.begin() + index, first, last);
+			return index;
+		}
+	}
+	else if (_size + count > CAPACITY)
+	{
+		if constexpr (OVERWRITE)
+		{
+			//         
+			std::size_t excess = _size + count - CAPACITY;
+			if (excess <= index)
+			{
+				erase(begin(), begin() + excess);
+				index -= excess;
+			}
+			else
+			{
+				erase(begin(), begin() + index);
+				std::advance(first, excess - index);
+				index = 0;
+			}
+		}
+		else
+			throw std::length_error("BoundedDeque is full!");
+	}
+
+	//          
+	std::size_t old_size = _size;
+	try
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
+	catch (...)
+	{
+		while (_size > old_size)
+			unchecked_pop_back();
+		throw;
+	}
+	std::rotate(begin() + index, begin() + old_size, end());
+	return index;
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::erase(iterator pos)
+{
+	return erase(pos, pos + 1);
+}
+
+//    
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::erase(iterator first, iterator last)
+{
+	size_type index = first._index;
+	size_type count = last._index - first._index;
+	if (count == 0)
+		return first;
+
+	if constexpr (GROW)
+	{
+		if (_spilled)
+		{
+			_spill.erase(_spill.begin() + index, _spill.begin() + index + count);
+			_spilled = !_spill.empty();
+			return iterator(this, index);
+		}
+	}
+
+	if (index < _size - index - count)
+	{
+		std::move_backward(begin(), first, last);
+		for (size_type i = 0; i < count; ++i)
+			unchecked_pop_front();
+	}
+	else
+	{
+		std::move(last, end(), first);
+		for (size_type i = 0; i < count; ++i)
+			unchecked_pop_back();
+	}
+	return iterator(this, index);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::begin() noexcept
+{
+	return iterator(this, 0);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::end() noexcept
+{
+	return iterator(this, size());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::begin() const noexcept
+{
+	return const_iterator(this, 0);
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::end() const noexcept
+{
+	return const_iterator(this, size());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::cbegin() const noexcept
+{
+	return begin();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::cend() const noexcept
+{
+	return end();
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reverse_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::rbegin() noexcept
+{
+	return reverse_iterator(end());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::reverse_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::rend() noexcept
+{
+	return reverse_iterator(begin());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reverse_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::rbegin() const noexcept
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline typename BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::const_reverse_iterator BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::rend() const noexcept
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator==(const BoundedDeque& other) const
+{
+	return size() == other.size() && std::equal(begin(), end(), other.begin());
+}
+
+template<typename _Ty, std::size_t _Capacity, typename _Overflow, typename _Alloc>
+inline bool BoundedDeque<_Ty, _Capacity, _Overflow, _Alloc>::operator!=(const BoundedDeque& other) const
+{
+	return !(*this == other);
+}
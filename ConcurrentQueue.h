@@ -0,0 +1,513 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.h"
+
+//    /     .
+//       fetch_add,  -
+//  ; ,      ,
+//    ,    .
+//     hazard pointers.
+//
+//  Deque     ;  (  
+//   )   .    -
+// 64 ,   4 ,   Deque:     
+//   ,      .
+
+template <typename _Ty, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Elements<64>>
+class ConcurrentQueue
+{
+private:
+	static constexpr std::size_t BLOCK_SIZE = _BlockPolicy::template size<_Ty>;
+	static constexpr std::size_t CACHE_LINE = 64;
+	static constexpr std::size_t MAX_HAZARDS = 128;
+	static constexpr std::size_t RETIRE_THRESHOLD = 2 * MAX_HAZARDS;
+
+	static_assert(std::has_single_bit(BLOCK_SIZE), "block size must be a power of two");
+
+	enum Slot_State : std::uint8_t
+	{
+		SLOT_EMPTY,
+		SLOT_READY,
+		SLOT_SKIPPED
+	};
+
+	struct Slot
+	{
+		std::atomic<std::uint8_t> state{ SLOT_EMPTY };
+		alignas(_Ty) unsigned char storage[sizeof(_Ty)];
+
+		_Ty* value() { return reinterpret_cast<_Ty*>(storage); }
+	};
+
+	struct Node
+	{
+		alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_index{ 0 };
+		alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_index{ 0 };
+		std::atomic<Node*> next{ nullptr };
+		Node* retired_next = nullptr;
+		Slot slots[BLOCK_SIZE];
+	};
+
+	struct alignas(CACHE_LINE) Hazard
+	{
+		std::atomic<Node*> node{ nullptr };
+		std::atomic<bool> owned{ false };
+	};
+
+	using _Alty = typename std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+	using _Alty_traits = std::allocator_traits<_Alty>;
+	using _Node_alloc = typename _Alty_traits::template rebind_alloc<Node>;
+	using _Node_traits = std::allocator_traits<_Node_alloc>;
+
+	[[no_unique_address]] _Alty _alloc;
+
+	alignas(CACHE_LINE) std::atomic<Node*> _head{ nullptr };
+	alignas(CACHE_LINE) std::atomic<Node*> _tail{ nullptr };
+	alignas(CACHE_LINE) std::atomic<Node*> _retired{ nullptr };
+	std::atomic<std::size_t> _retired_count{ 0 };
+
+	mutable Hazard _hazards[MAX_HAZARDS];
+
+	//   hazard pointer    :  
+	// MAX_HAZARDS  acquire_hazard  
+	class Hazard_Guard
+	{
+	public:
+		explicit Hazard_Guard(const ConcurrentQueue& queue) : _hazard(queue.acquire_hazard()) {}
+		Hazard_Guard(const Hazard_Guard&) = delete;
+		Hazard_Guard& operator=(const Hazard_Guard&) = delete;
+		~Hazard_Guard() { release_hazard(_hazard); }
+
+		Hazard* get() const noexcept { return _hazard; }
+
+	private:
+		Hazard* _hazard;
+	};
+
+	Node* create_node();
+	void delete_node(Node* node);
+	void destroy_values(Node* node);
+
+	Hazard* acquire_hazard() const;
+	static void release_hazard(Hazard* hazard);
+	static Node* protect(Hazard* hazard, const std::atomic<Node*>& source);
+	void retire(Node* node);
+	void reclaim();
+
+	bool publish(Node* node, std::size_t index, _Ty& value);
+	void push_value(_Ty& value);
+
+public:
+	using value_type = _Ty;
+	using allocator_type = _Alloc;
+	using size_type = std::size_t;
+
+	ConcurrentQueue();
+	explicit ConcurrentQueue(const allocator_type& alloc);
+	ConcurrentQueue(const ConcurrentQueue&) = delete;
+	ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+	~ConcurrentQueue();
+
+	allocator_type get_allocator() const noexcept;
+
+	//  : try_push  ,   
+	bool try_push(const _Ty& value);
+	bool try_push(_Ty&& value);
+	bool try_pop(_Ty& out);
+
+	template <std::input_iterator _InIt>
+	size_type try_push_bulk(_InIt first, size_type count);
+	template <typename _OutIt>
+	size_type try_pop_bulk(_OutIt dest, size_type max_count);
+
+	//    
+	bool empty() const noexcept;
+
+	static constexpr size_type block_size() noexcept;
+};
+
+// IMPLEMENTATION
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::Node* ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::create_node()
+{
+	_Node_alloc node_alloc(_alloc);
+	Node* node = _Node_traits::allocate(node_alloc, 1);
+	::new (static_cast<void*>(node)) Node();
+	return node;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::delete_node(Node* node)
+{
+	node->~Node();
+	_Node_alloc node_alloc(_alloc);
+	_Node_traits::deallocate(node_alloc, node, 1);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::destroy_values(Node* node)
+{
+	for (Slot& slot : node->slots)
+	{
+		if (slot.state.load(std::memory_order_relaxed) == SLOT_READY)
+			_Alty_traits::destroy(_alloc, slot.value());
+	}
+}
+
+//    ,   ,    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::Hazard* ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::acquire_hazard() const
+{
+	static thread_local std::size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+	for (std::size_t i = hint;; ++i)
+	{
+		Hazard& hazard = _hazards[i % MAX_HAZARDS];
+		if (!hazard.owned.load(std::memory_order_relaxed)
+			&& !hazard.owned.exchange(true, std::memory_order_acquire))
+		{
+			hint = i;
+			return &hazard;
+		}
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::release_hazard(Hazard* hazard)
+{
+	hazard->node.store(nullptr, std::memory_order_release);
+	hazard->owned.store(false, std::memory_order_release);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::Node* ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::protect(Hazard* hazard, const std::atomic<Node*>& source)
+{
+	Node* node = source.load(std::memory_order_acquire);
+	while (true)
+	{
+		hazard->node.store(node, std::memory_order_seq_cst);
+		Node* current = source.load(std::memory_order_seq_cst);
+		if (current == node)
+			return node;
+		node = current;
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::retire(Node* node)
+{
+	node->retired_next = _retired.load(std::memory_order_relaxed);
+	while (!_retired.compare_exchange_weak(node->retired_next, node, std::memory_order_release, std::memory_order_relaxed))
+		;
+
+	if (_retired_count.fetch_add(1, std::memory_order_relaxed) + 1 >= RETIRE_THRESHOLD)
+		reclaim();
+}
+
+//    ; ,   - ,  
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::reclaim()
+{
+	Node* list = _retired.exchange(nullptr, std::memory_order_acquire);
+	std::size_t freed = 0;
+
+	while (list)
+	{
+		Node* node = std::exchange(list, list->retired_next);
+
+		bool protected_node = false;
+		for (Hazard& hazard : _hazards)
+		{
+			if (hazard.node.load(std::memory_order_seq_cst) == node)
+			{
+				protected_node = true;
+				break;
+			}
+		}
+
+		if (protected_node)
+		{
+			node->retired_next = _retired.load(std::memory_order_relaxed);
+			while (!_retired.compare_exchange_weak(node->retired_next, node, std::memory_order_release, std::memory_order_relaxed))
+				;
+		}
+		else
+		{
+			delete_node(node);
+			++freed;
+		}
+	}
+	_retired_count.fetch_sub(freed, std::memory_order_relaxed);
+}
+
+// false:     ,    value
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::publish(Node* node, std::size_t index, _Ty& value)
+{
+	Slot& slot = node->slots[index];
+	_Alty_traits::construct(_alloc, slot.value(), std::move(value));
+
+	std::uint8_t expected = SLOT_EMPTY;
+	if (slot.state.compare_exchange_strong(expected, SLOT_READY, std::memory_order_release, std::memory_order_relaxed))
+		return true;
+
+	value = std::move(*slot.value());
+	_Alty_traits::destroy(_alloc, slot.value());
+	return false;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::push_value(_Ty& value)
+{
+	Hazard_Guard guard(*this);
+	Hazard* hazard = guard.get();
+	while (true)
+	{
+		Node* tail = protect(hazard, _tail);
+		std::size_t index = tail->enqueue_index.fetch_add(1, std::memory_order_acq_rel);
+
+		if (index < BLOCK_SIZE)
+		{
+			if (publish(tail, index, value))
+				break;
+			continue;
+		}
+
+		//  :      
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (next == nullptr)
+		{
+			Node* node = create_node();
+			node->enqueue_index.store(1, std::memory_order_relaxed);
+			_Alty_traits::construct(_alloc, node->slots[0].value(), std::move(value));
+			node->slots[0].state.store(SLOT_READY, std::memory_order_relaxed);
+
+			if (tail->next.compare_exchange_strong(next, node, std::memory_order_release, std::memory_order_acquire))
+			{
+				_tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+				break;
+			}
+
+			value = std::move(*node->slots[0].value());
+			_Alty_traits::destroy(_alloc, node->slots[0].value());
+			delete_node(node);
+		}
+		_tail.compare_exchange_strong(tail, next, std::memory_order_release, std::memory_order_relaxed);
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::ConcurrentQueue()
+	: ConcurrentQueue(allocator_type())
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::ConcurrentQueue(const allocator_type& alloc)
+	: _alloc(alloc)
+{
+	Node* node = create_node();
+	_head.store(node, std::memory_order_relaxed);
+	_tail.store(node, std::memory_order_relaxed);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::~ConcurrentQueue()
+{
+	Node* node = _head.load(std::memory_order_relaxed);
+	while (node)
+	{
+		destroy_values(node);
+		delete_node(std::exchange(node, node->next.load(std::memory_order_relaxed)));
+	}
+
+	Node* retired = _retired.load(std::memory_order_relaxed);
+	while (retired)
+		delete_node(std::exchange(retired, retired->retired_next));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::allocator_type ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::get_allocator() const noexcept
+{
+	return allocator_type(_alloc);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::try_push(const _Ty& value)
+{
+	_Ty copy(value);
+	push_value(copy);
+	return true;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::try_push(_Ty&& value)
+{
+	push_value(value);
+	return true;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::try_pop(_Ty& out)
+{
+	return try_pop_bulk(&out, 1) == 1;
+}
+
+//      fetch_add.   
+//   ,     ,  
+//    :      .
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<std::input_iterator _InIt>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::size_type ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::try_push_bulk(_InIt first, size_type count)
+{
+	if (count == 0)
+		return 0;
+
+	Hazard_Guard guard(*this);
+	Hazard* hazard = guard.get();
+	size_type left = count;
+	_Ty value(*first);
+	bool have_value = true;
+
+	while (have_value)
+	{
+		Node* tail = protect(hazard, _tail);
+		std::size_t index = tail->enqueue_index.fetch_add(left, std::memory_order_acq_rel);
+
+		if (index < BLOCK_SIZE)
+		{
+			std::size_t end = std::min(BLOCK_SIZE, index + left);
+			for (; index < end; ++index)
+			{
+				if (!publish(tail, index, value))
+					break;
+
+				have_value = --left > 0;
+				if (!have_value)
+				{
+					++index;
+					break;
+				}
+				value = _Ty(*++first);
+			}
+
+			// ,       
+			for (std::size_t i = index; i < end; ++i)
+			{
+				std::uint8_t expected = SLOT_EMPTY;
+				tail->slots[i].state.compare_exchange_strong(expected, SLOT_SKIPPED, std::memory_order_relaxed);
+			}
+			continue;
+		}
+
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (next == nullptr)
+		{
+			Node* node = create_node();
+			node->enqueue_index.store(1, std::memory_order_relaxed);
+			_Alty_traits::construct(_alloc, node->slots[0].value(), std::move(value));
+			node->slots[0].state.store(SLOT_READY, std::memory_order_relaxed);
+
+			if (tail->next.compare_exchange_strong(next, node, std::memory_order_release, std::memory_order_acquire))
+			{
+				_tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+				have_value = --left > 0;
+				if (have_value)
+					value = _Ty(*++first);
+				continue;
+			}
+
+			value = std::move(*node->slots[0].value());
+			_Alty_traits::destroy(_alloc, node->slots[0].value());
+			delete_node(node);
+		}
+		_tail.compare_exchange_strong(tail, next, std::memory_order_release, std::memory_order_relaxed);
+	}
+	return count;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename _OutIt>
+typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::size_type ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::try_pop_bulk(_OutIt dest, size_type max_count)
+{
+	Hazard_Guard guard(*this);
+	Hazard* hazard = guard.get();
+	size_type popped = 0;
+
+	while (popped < max_count)
+	{
+		Node* head = protect(hazard, _head);
+		std::size_t dequeue_index = head->dequeue_index.load(std::memory_order_acquire);
+		std::size_t enqueue_index = std::min(head->enqueue_index.load(std::memory_order_acquire), BLOCK_SIZE);
+		Node* next = head->next.load(std::memory_order_acquire);
+
+		if (dequeue_index >= enqueue_index && next == nullptr)
+			break;
+
+		//   ,    
+		std::size_t want = std::max<std::size_t>(1, std::min(max_count - popped,
+			enqueue_index > dequeue_index ? enqueue_index - dequeue_index : 1));
+		std::size_t index = head->dequeue_index.fetch_add(want, std::memory_order_acq_rel);
+
+		if (index >= BLOCK_SIZE)
+		{
+			next = head->next.load(std::memory_order_acquire);
+			if (next == nullptr)
+				break;
+
+			//      ,    
+			Node* tail = head;
+			_tail.compare_exchange_strong(tail, next, std::memory_order_release, std::memory_order_relaxed);
+
+			if (_head.compare_exchange_strong(head, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+			{
+				hazard->node.store(nullptr, std::memory_order_release);
+				retire(head);
+			}
+			continue;
+		}
+
+		std::size_t end = std::min(BLOCK_SIZE, index + want);
+		for (; index < end; ++index)
+		{
+			Slot& slot = head->slots[index];
+			if (slot.state.exchange(SLOT_SKIPPED, std::memory_order_acquire) != SLOT_READY)
+				continue;
+
+			*dest = std::move(*slot.value());
+			++dest;
+			_Alty_traits::destroy(_alloc, slot.value());
+			++popped;
+		}
+	}
+	return popped;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::empty() const noexcept
+{
+	Hazard_Guard guard(*this);
+	Hazard* hazard = guard.get();
+	Node* head = protect(hazard, _head);
+	std::size_t enqueue_index = std::min(head->enqueue_index.load(std::memory_order_acquire), BLOCK_SIZE);
+	bool result = head->dequeue_index.load(std::memory_order_acquire) >= enqueue_index
+		&& head->next.load(std::memory_order_acquire) == nullptr;
+	return result;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+constexpr typename ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::size_type ConcurrentQueue<_Ty, _Alloc, _BlockPolicy>::block_size() noexcept
+{
+	return BLOCK_SIZE;
+}
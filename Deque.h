@@ -5,36 +5,211 @@
 #include <memory>
 #include <stdexcept>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <bit>
+#include <ranges>
+#include <memory_resource>
+#include <span>
+#include <numeric>
+#include <functional>
+
+//    ;    ,
+//       .
+
+template <std::size_t _Bytes>
+struct Deque_Block_Bytes
+{
+	template <typename _Ty>
+	static constexpr std::size_t size = std::bit_floor(std::max<std::size_t>(1, _Bytes / sizeof(_Ty)));
+};
+
+template <std::size_t _Count>
+struct Deque_Block_Elements
+{
+	static_assert(std::has_single_bit(_Count), "block size must be a power of two");
+
+	template <typename _Ty>
+	static constexpr std::size_t size = _Count;
+};
+
+//   . Deque_No_Stats ,   
+//  ,      ,  .
+
+struct Deque_No_Stats
+{
+	void block_allocated(std::size_t) noexcept {}
+	void block_freed() noexcept {}
+	void map_allocated() noexcept {}
+	void size_grew(std::size_t) noexcept {}
+	void elements_shifted(std::size_t) noexcept {}
+};
+
+struct Deque_Stats
+{
+	std::size_t block_allocations = 0;
+	std::size_t block_frees = 0;
+	std::size_t map_allocations = 0;
+	std::size_t peak_size = 0;
+	std::size_t peak_blocks = 0;
+	std::size_t shifts = 0;            // insert/erase  
+	std::size_t shifted_elements = 0;  //    
+
+	//    
+	std::size_t bytes_reserved = 0;    //  ( )  
+	std::size_t bytes_live = 0;        //  
+
+	void block_allocated(std::size_t block_count) noexcept
+	{
+		++block_allocations;
+		peak_blocks = std::max(peak_blocks, block_count);
+	}
+	void block_freed() noexcept { ++block_frees; }
+	void map_allocated() noexcept { ++map_allocations; }
+	void size_grew(std::size_t size) noexcept { peak_size = std::max(peak_size, size); }
+	void elements_shifted(std::size_t count) noexcept
+	{
+		++shifts;
+		shifted_elements += count;
+	}
+};
 
-template <typename _Ty>
+template <typename _Ty, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Bytes<4096>, std::size_t _InlineN = 0, typename _Stats = Deque_No_Stats>
 class Deque
 {
 private:
-	static constexpr std::size_t BLOCK_SIZE = 64;
+	static constexpr std::size_t INLINE_SIZE = _InlineN;
+	static constexpr bool HAS_INLINE = INLINE_SIZE > 0;
+	//       ,  
+	//       
+	static constexpr std::size_t BLOCK_SIZE = std::max(_BlockPolicy::template size<_Ty>,
+		HAS_INLINE ? std::bit_ceil(INLINE_SIZE + 1) : std::size_t(1));
+	static constexpr std::size_t BLOCK_SHIFT = std::countr_zero(BLOCK_SIZE);
+	static constexpr std::size_t BLOCK_MASK = BLOCK_SIZE - 1;
+	static constexpr std::size_t DEFAULT_SPARE_BLOCKS = 2;
+	static constexpr std::size_t MIN_MAP_SIZE = 8;
+
+	static_assert(std::has_single_bit(BLOCK_SIZE), "block size must be a power of two");
+	static_assert(INLINE_SIZE < BLOCK_SIZE, "inline storage must be smaller than a block");
+
+	using _Alty = typename std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+	using _Alty_traits = std::allocator_traits<_Alty>;
+
 	using Block = _Ty*;
 	using Map = Block*;
 
-	Map _map;
-	std::size_t _size;
-	size_t _map_size;
-	size_t _start_block;
-	std::size_t _start_offset;
-	size_t _finish_block;
-	std::size_t _finish_offset;
+	using _Map_alloc = typename _Alty_traits::template rebind_alloc<Block>;
+	using _Map_traits = std::allocator_traits<_Map_alloc>;
+
+	static_assert(std::is_same_v<typename _Alty_traits::pointer, _Ty*>,
+		"Deque requires an allocator with raw pointers");
+
+	// memcpy    ,   
+	//   construct (pmr      placement new)
+	static constexpr bool TRIVIAL_COPY = std::is_trivially_copyable_v<_Ty>
+		&& (!requires(_Alty& alloc, _Ty* ptr, const _Ty& value) { alloc.construct(ptr, value); }
+			|| std::is_same_v<_Alty, std::pmr::polymorphic_allocator<_Ty>>);
+
+	//    :      
+	static constexpr bool TRIVIAL_DESTROY = std::is_trivially_destructible_v<_Ty>
+		&& (!requires(_Alty& alloc, _Ty* ptr) { alloc.destroy(ptr); }
+			|| std::is_same_v<_Alty, std::pmr::polymorphic_allocator<_Ty>>);
+
+	//     :     
+	Map _map = nullptr;
+	std::size_t _size = 0;
+	size_t _map_size = 0;
+	size_t _start_block = 0;
+	std::size_t _start_offset = 0;
+	size_t _finish_block = 0;
+	std::size_t _finish_offset = 0;
+	[[no_unique_address]] _Alty _alloc;
+
+	//      :    ,
+	//  0  -  ; offset    INLINE_SIZE
+	struct Inline_Storage
+	{
+		Block map[1];
+		alignas(_Ty) unsigned char elements[sizeof(_Ty) * (HAS_INLINE ? INLINE_SIZE : 1)];
+	};
+	struct No_Inline_Storage {};
+	[[no_unique_address]] std::conditional_t<HAS_INLINE, Inline_Storage, No_Inline_Storage> _inline;
+
+	//  ,      
+	Block _spare = nullptr;
+	size_t _spare_count = 0;
+	size_t _spare_limit = DEFAULT_SPARE_BLOCKS;
+
+	//   :     
+	size_t _block_count = 0;
+
+	// :       
+	size_t _shrink_after = 0;
+	size_t _low_occupancy_drains = 0;
 
-	void allocate_map(std::size_t n_blocks);
-	void reallocate_map(bool add_to_front);
+	//  reserve_*        shrink_to_fit
+	bool _keep_reserve = false;
+	[[no_unique_address]] _Stats _stats;
+
+	Map create_map(std::size_t n_blocks);
+	void delete_map(Map map, std::size_t n_blocks);
+
+	void reallocate_map(std::size_t blocks_to_add, bool add_to_front);
+	void recenter_map(std::size_t new_start_block);
+	void reserve_back_blocks(std::size_t count);
+	void reserve_front_blocks(std::size_t count);
 	void allocate_block(std::size_t index);
 	void deallocate_block(std::size_t index);
-
-	void resize_map(std::size_t new_map_size);
+	void recycle_block(std::size_t index);
+	void prepare_back_block();
+	void prepare_front_block();
+
+	//        
+	static constexpr bool NOTHROW_STEAL = !HAS_INLINE || std::is_nothrow_move_constructible_v<_Ty>;
+
+	bool is_inline() const noexcept;
+	bool inline_back_full() const noexcept;
+	std::size_t inline_room(std::size_t in_place) const noexcept;
+	void enter_inline(std::size_t offset) noexcept;
+	bool make_inline_room(std::size_t count, bool at_front);
+	void leave_inline();
+	void steal_inline(Deque& other) noexcept(NOTHROW_STEAL);
+
+	static constexpr bool CAN_CACHE_BLOCKS = BLOCK_SIZE * sizeof(_Ty) >= sizeof(Block);
+
+	Block acquire_block();
+	void release_block(Block block);
+	void release_spare_blocks(std::size_t keep);
+	void release_reserve_blocks();
+	void note_block_drained();
+	std::size_t live_blocks() const noexcept;
+
+	void destroy_range(_Ty* first, std::size_t count);
+	void destroy_elements();
+	void erase_back(std::size_t count);
+	void erase_front(std::size_t count);
+	void release_back_blocks(std::size_t last_block);
 	void destroy_all();
+	void steal(Deque& other) noexcept(NOTHROW_STEAL);
+
+	template <typename _It>
+	void append_n(_It first, std::size_t count);
+	void append_fill(std::size_t count, const _Ty& value);
+	template <typename _It>
+	void prepend_n(_It first, std::size_t count);
 
 	_Ty* block_pointer(std::size_t block, std::size_t offset);
 	const _Ty* block_pointer(std::size_t block, std::size_t offset) const;
+	_Ty* element_pointer(std::size_t index);
+
+	void move_elements(std::size_t first, std::size_t last, std::size_t dest);
+	void move_elements_backward(std::size_t first, std::size_t last, std::size_t dest_last);
 
 public:
 	using value_type = _Ty;
+	using allocator_type = _Alloc;
 	using pointer = _Ty*;
 	using const_pointer = const _Ty*;
 	using reference = _Ty&;
@@ -59,10 +234,10 @@ public:
 		pointer operator->() const;
 
 		Iterator& operator++();
-		Iterator& operator++(int);
+		Iterator operator++(int);
 
 		Iterator& operator--();
-		Iterator& operator--(int);
+		Iterator operator--(int);
 
 		Iterator operator+(difference_type n) const;
 		Iterator operator-(difference_type n) const;
@@ -86,7 +261,7 @@ public:
 		size_type _block = 0;
 		size_type _offset = 0;
 
-		friend class Deque<_Ty>;
+		friend class Deque;
 		friend class Const_Iterator;
 	};
 
@@ -131,9 +306,101 @@ public:
 		bool operator>=(const Const_Iterator& rhs) const;
 
 	private:
-		const Map _map_ptr;
-		size_type _block;
-		size_type _offset;
+		Map _map_ptr = nullptr;
+		size_type _block = 0;
+		size_type _offset = 0;
+
+		friend class Deque;
+	};
+
+	//     ,      
+	template <typename _Elem>
+	class Segment_View
+	{
+	public:
+		class Segment_Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::span<_Elem>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = std::span<_Elem>;
+
+			Segment_Iterator() noexcept = default;
+
+			std::span<_Elem> operator*() const;
+
+			Segment_Iterator& operator++();
+			Segment_Iterator operator++(int);
+
+			bool operator==(const Segment_Iterator& rhs) const;
+			bool operator!=(const Segment_Iterator& rhs) const;
+
+		private:
+			Segment_Iterator(const Segment_View& view, size_type block);
+
+			Map _map_ptr = nullptr;
+			size_type _block = 0;
+			size_type _start_block = 0;
+			size_type _start_offset = 0;
+			size_type _finish_block = 0;
+			size_type _finish_offset = 0;
+
+			friend class Segment_View;
+		};
+
+		Segment_Iterator begin() const;
+		Segment_Iterator end() const;
+		size_type size() const;
+		bool empty() const;
+
+	private:
+		Segment_View(Map map, size_type start_block, size_type start_offset,
+			size_type finish_block, size_type finish_offset);
+
+		Map _map_ptr;
+		size_type _start_block;
+		size_type _start_offset;
+		size_type _finish_block;
+		size_type _finish_offset;
+		size_type _end_block;
+
+		friend class Deque;
+	};
+
+	//     :   
+	//     ;   
+	template <typename _Elem>
+	class Index_Cursor
+	{
+	public:
+		_Elem& operator[](size_type index);
+
+	private:
+		Index_Cursor(Map map, size_type start_block, size_type start_offset) noexcept;
+
+		_Elem& seek(size_type index);
+
+		Map _map_ptr;
+		size_type _start_block;
+		size_type _start_offset;
+		_Elem* _block_ptr = nullptr;
+		size_type _block_first; //     ,   2^N
+
+		friend class Deque;
+	};
+
+	// ,      ( inline_bytes)
+	struct Memory_Usage
+	{
+		size_type map_bytes = 0;
+		size_type block_bytes = 0;        //   ,  
+		size_type spare_bytes = 0;        //     
+		size_type inline_bytes = 0;       //    
+		size_type live_bytes = 0;
+		size_type front_slack_bytes = 0;  //    
+		size_type back_slack_bytes = 0;   //   
 	};
 
 
@@ -142,24 +409,41 @@ public:
 	using reverse_iterator = std::reverse_iterator<Iterator>;
 	using const_reverse_iterator = std::reverse_iterator<Const_Iterator>;
 
-	Deque();
-	Deque(size_type count, const_reference value = _Ty());
-	Deque(std::initializer_list<value_type> init);
+	Deque() noexcept(noexcept(allocator_type()));
+	explicit Deque(const allocator_type& alloc) noexcept;
+	explicit Deque(size_type count, const allocator_type& alloc = allocator_type());
+	Deque(size_type count, const_reference value, const allocator_type& alloc = allocator_type());
+	Deque(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type());
 	Deque(const Deque& other);
-	Deque(Deque&& other) noexcept;
+	Deque(const Deque& other, const allocator_type& alloc);
+	Deque(Deque&& other) noexcept(NOTHROW_STEAL);
+	Deque(Deque&& other, const allocator_type& alloc);
 	~Deque();
 
 	Deque& operator=(const Deque& other);
-	Deque& operator=(Deque&& other) noexcept;
+	Deque& operator=(Deque&& other) noexcept(NOTHROW_STEAL
+		&& (_Alty_traits::propagate_on_container_move_assignment::value
+			|| _Alty_traits::is_always_equal::value));
+
+	allocator_type get_allocator() const noexcept;
 
 	void assign(std::initializer_list<value_type> init);
 	void assign(size_type count, const_reference value);
 
 	void push_back(const_reference value);
+	void push_back(value_type&& value);
 	void push_front(const_reference value);
+	void push_front(value_type&& value);
 
 	void pop_back();
 	void pop_front();
+	//    ;  ,   
+	void unchecked_pop_back() noexcept;
+	void unchecked_pop_front() noexcept;
+	void pop_back_n(size_type count);
+	void pop_front_n(size_type count);
+	template <typename _OutIt>
+	_OutIt drain_front(size_type count, _OutIt dest);
 
 	template <typename... Args>
 	reference emplace_back(Args&&... args);
@@ -182,16 +466,52 @@ public:
 	reference at(size_type index);
 	const_reference at(size_type index) const;
 
+	static constexpr size_type block_size() noexcept;
 	size_type capacity() const noexcept;
+	size_type capacity_front() const noexcept;
+	size_type capacity_back() const noexcept;
+	void reserve_front(size_type count);
+	void reserve_back(size_type count);
 	size_type size() const;
 	bool empty() const;
 
-	void resize(size_type new_size, const_reference value = _Ty());
+	size_type spare_blocks() const noexcept;
+	size_type spare_block_limit() const noexcept;
+	void set_spare_block_limit(size_type limit);
+	void shrink_to_fit();
+	size_type auto_shrink() const noexcept;
+	void set_auto_shrink(size_type drains);
+
+	//   ;  Deque_Stats   
+	_Stats stats() const;
+
+	Memory_Usage memory_usage() const noexcept;
+	// func(block, block_capacity, live_first, live_last)    
+	//  ;    - [live_first, live_last),   
+	template<typename _Fn>
+	void for_each_block(_Fn&& func) const;
+
+	void resize(size_type new_size);
+	void resize(size_type new_size, const_reference value);
 
 	void swap(Deque& other);
 
 	iterator insert(iterator pos, const_reference value);
+	iterator insert(iterator pos, value_type&& value);
+	template <std::input_iterator _InIt>
+	iterator insert(iterator pos, _InIt first, _InIt last);
 	iterator erase(iterator pos);
+	iterator erase(iterator first, iterator last);
+
+	template <std::input_iterator _InIt>
+	void append(_InIt first, _InIt last);
+	template <std::input_iterator _InIt>
+	void prepend(_InIt first, _InIt last);
+
+	template <std::ranges::input_range _Range>
+	void append_range(_Range&& range);
+	template <std::ranges::input_range _Range>
+	void prepend_range(_Range&& range);
 
 	// ITERATOR 
 
@@ -209,671 +529,1910 @@ public:
 	const_reverse_iterator crbegin() const;
 	const_reverse_iterator crend() const;
 
+	Segment_View<_Ty> segments();
+	Segment_View<const _Ty> segments() const;
+
+	Index_Cursor<_Ty> cursor() noexcept;
+	Index_Cursor<const _Ty> cursor() const noexcept;
+
 	bool operator==(const Deque& other) const;
 	bool operator!=(const Deque& other) const;
 
 };
 
+//  _InlineN     ;    
+//  ,        _InlineN
+template <typename _Ty, std::size_t _InlineN, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Bytes<4096>>
+using SmallDeque = Deque<_Ty, _Alloc, _BlockPolicy, _InlineN>;
+
 // IMPLEMENTATION
 
-template<typename _Ty>
-void Deque<_Ty>::allocate_map(std::size_t n_blocks)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Map Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::create_map(std::size_t n_blocks)
 {
-	if (n_blocks < 8) //   
-		n_blocks = 8; 
-
-	_map = static_cast<Map>(::operator new(n_blocks * sizeof(Block)));
+	_Map_alloc map_alloc(_alloc);
+	Map map = _Map_traits::allocate(map_alloc, n_blocks);
 	for (std::size_t i = 0; i < n_blocks; ++i)
-		_map[i] = nullptr;
+		map[i] = nullptr;
+	_stats.map_allocated();
 
-	_map_size = n_blocks;
+	return map;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::reallocate_map(bool add_to_front)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::delete_map(Map map, std::size_t n_blocks)
 {
-	size_type old_block_count = _finish_block - _start_block + 1;
-	size_type new_map_size = std::max(static_cast<size_type>(8), _map_size * 2);
+	_Map_alloc map_alloc(_alloc);
+	_Map_traits::deallocate(map_alloc, map, n_blocks);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reallocate_map(std::size_t blocks_to_add, bool add_to_front)
+{
+	// _finish_block       
+	size_type first = _start_block;
+	size_type last = _finish_block;
+
+	//  :    ,    
+	if (_keep_reserve)
+	{
+		for (size_type i = 0; i < first; ++i)
+		{
+			if (_map[i])
+			{
+				first = i;
+				break;
+			}
+		}
+		for (size_type i = _map_size; i-- > last + 1;)
+		{
+			if (_map[i])
+			{
+				last = i;
+				break;
+			}
+		}
+	}
 
-	Map new_map = static_cast<Map>(::operator new(new_map_size * sizeof(Block)));
-	for (size_type i = 0; i < new_map_size; ++i)
-		new_map[i] = nullptr;
+	size_type live_count = _finish_block - _start_block;
+	size_type old_block_count = last - first + 1;
+	size_type new_block_count = old_block_count + blocks_to_add;
+	size_type front_shift = (add_to_front ? blocks_to_add : 0) + (_start_block - first);
 
-	size_type new_start_block = add_to_front ? new_map_size / 4 : (new_map_size / 2 - old_block_count / 2);
+	assert(!is_inline());
 
-	for (size_type i = 0; i < old_block_count; ++i)
-		new_map[new_start_block + i] = _map[_start_block + i];
+	//     (   ):   ,  
+	if (_map && _map_size > 2 * new_block_count)
+	{
+		recenter_map((_map_size - new_block_count) / 2 + front_shift);
+		return;
+	}
+
+	size_type new_map_size = std::max<size_type>(MIN_MAP_SIZE, _map_size + std::max(_map_size, blocks_to_add) + 2);
+
+	Map new_map = create_map(new_map_size);
+
+	size_type new_start_block = (new_map_size - new_block_count) / 2 + front_shift;
+
+	//    [_start_block, _finish_block]    
+	for (size_type i = 0; i < _map_size; ++i)
+	{
+		if (_map[i] == nullptr)
+			continue;
+
+		size_type j = new_start_block + i - _start_block;
+		if (i + new_start_block >= _start_block && j < new_map_size)
+			new_map[j] = _map[i];
+		else
+			release_block(_map[i]);
+	}
 
-	::operator delete(_map);
+	if (_map)
+		delete_map(_map, _map_size);
 
 	_map = new_map;
 	_start_block = new_start_block;
-	_finish_block = _start_block + old_block_count - 1;
+	_finish_block = _start_block + live_count;
 	_map_size = new_map_size;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::allocate_block(std::size_t index)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::recenter_map(std::size_t new_start_block)
 {
-	_map[index] = static_cast<Block>(::operator new(BLOCK_SIZE * sizeof(value_type)));
-}
+	difference_type delta = static_cast<difference_type>(new_start_block) - static_cast<difference_type>(_start_block);
 
-template<typename _Ty>
-void Deque<_Ty>::deallocate_block(std::size_t index)
-{
-	::operator delete(static_cast<void*>(_map[index]));
-	_map[index] = nullptr;
+	auto move_slot = [this, delta](size_type i)
+	{
+		if (_map[i] == nullptr)
+			return;
+
+		Block block = std::exchange(_map[i], nullptr);
+		difference_type j = static_cast<difference_type>(i) + delta;
+		if (j >= 0 && j < static_cast<difference_type>(_map_size))
+			_map[j] = block;
+		else
+			release_block(block);
+	};
+
+	//   ,      
+	if (delta < 0)
+	{
+		for (size_type i = 0; i < _map_size; ++i)
+			move_slot(i);
+	}
+	else
+	{
+		for (size_type i = _map_size; i-- > 0;)
+			move_slot(i);
+	}
+
+	_finish_block = new_start_block + (_finish_block - _start_block);
+	_start_block = new_start_block;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::resize_map(std::size_t new_map_size)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reserve_back_blocks(std::size_t count)
 {
-	Map new_map = static_cast<Map>(::operator new(new_map_size * sizeof(Block)));
-	for (std::size_t i = 0; i < new_map_size; ++i)
-		new_map[i] = nullptr;
+	if (count == 0)
+		return;
 
-	::operator delete(_map);
-	_map = new_map;
-	_map_size = new_map_size;
+	if constexpr (HAS_INLINE)
+	{
+		if (_map == nullptr && count <= INLINE_SIZE)
+		{
+			enter_inline(0);
+			return;
+		}
+		if (is_inline())
+		{
+			if (_finish_offset + count <= INLINE_SIZE || make_inline_room(count, false))
+				return;
+			leave_inline();
+		}
+	}
+
+	size_type last_block = _finish_block + ((_finish_offset + count - 1) >> BLOCK_SHIFT);
+	if (last_block >= _map_size)
+	{
+		reallocate_map(last_block - _finish_block, false);
+		last_block = _finish_block + ((_finish_offset + count - 1) >> BLOCK_SHIFT);
+	}
+
+	for (size_type i = _finish_block; i <= last_block; ++i)
+	{
+		if (_map[i] == nullptr)
+			allocate_block(i);
+	}
 }
 
-template<typename _Ty>
-void Deque<_Ty>::destroy_all()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reserve_front_blocks(std::size_t count)
 {
-	if (_map)
+	if (count <= _start_offset)
+		return;
+
+	if constexpr (HAS_INLINE)
 	{
-		for (size_type i = 0; i < _map_size; ++i)
+		if (_map == nullptr && count <= INLINE_SIZE)
 		{
-			if (_map[i])
-			{
-				for (size_type j = 0; j < BLOCK_SIZE; ++j)
-					std::destroy_at(&_map[i][j]);
-			}
-			deallocate_block(i);
+			enter_inline(INLINE_SIZE);
+			return;
 		}
+		if (is_inline())
+		{
+			if (make_inline_room(count, true))
+				return;
+			leave_inline();
+			if (count <= _start_offset)
+				return;
+		}
+	}
 
-		::operator delete(static_cast<void*>(_map));
-		_map = nullptr;
+	size_type need = (count - _start_offset + BLOCK_MASK) >> BLOCK_SHIFT;
+	if (need > _start_block)
+		reallocate_map(need, true);
+
+	for (size_type i = _start_block - need; i < _start_block; ++i)
+	{
+		if (_map[i] == nullptr)
+			allocate_block(i);
 	}
-	_map_size = 0;
-	_start_block = _start_offset = _finish_block = _finish_offset = 0;
 }
 
-template<typename _Ty>
-inline _Ty* Deque<_Ty>::block_pointer(std::size_t block, std::size_t offset)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::allocate_block(std::size_t index)
 {
-	return _map[block] + offset;
+	_map[index] = acquire_block();
 }
 
-template<typename _Ty>
-inline const _Ty* Deque<_Ty>::block_pointer(std::size_t block, std::size_t offset) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::deallocate_block(std::size_t index)
 {
-	return _map[block] + offset;
+	if (is_inline())
+		return;
+
+	_Alty_traits::deallocate(_alloc, _map[index], BLOCK_SIZE);
+	_map[index] = nullptr;
+	--_block_count;
+	_stats.block_freed();
 }
 
-template<typename _Ty>
-inline Deque<_Ty>::Deque()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::prepare_back_block()
 {
-	allocate_map(8);
-	_start_block = _map_size / 2;
-	_start_offset = 0;
-	_finish_block = _start_block;
-	_finish_offset = 0;
-	_size = 0;
-	allocate_block(_start_block);
+	if constexpr (HAS_INLINE)
+	{
+		if (_map == nullptr)
+		{
+			enter_inline(0);
+			return;
+		}
+		if (is_inline())
+		{
+			if (_finish_offset < INLINE_SIZE || make_inline_room(1, false))
+				return;
+			leave_inline();
+		}
+	}
+
+	if (_finish_block >= _map_size)
+		reallocate_map(1, false);
+
+	if (_map[_finish_block] == nullptr)
+		allocate_block(_finish_block);
 }
 
-template<typename _Ty>
-Deque<_Ty>::Deque(size_type count, const_reference value)
-	: Deque()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::prepare_front_block()
 {
-	for (size_type i = 0; i < count; ++i)
-		push_back(value);
+	if constexpr (HAS_INLINE)
+	{
+		if (_map == nullptr)
+		{
+			enter_inline(INLINE_SIZE);
+			return;
+		}
+		if (is_inline())
+		{
+			if (make_inline_room(1, true))
+				return;
+			leave_inline();
+			if (_start_offset != 0)
+				return;
+		}
+	}
+
+	if (_start_block == 0)
+		reallocate_map(1, true);
+
+	if (_map[_start_block - 1] == nullptr)
+		allocate_block(_start_block - 1);
+
+	--_start_block;
+	_start_offset = BLOCK_SIZE;
 }
 
-template<typename _Ty>
-Deque<_Ty>::Deque(std::initializer_list<value_type> init)
-	: Deque()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::is_inline() const noexcept
 {
-	for (const auto& elem : init)
-		push_back(elem);
+	if constexpr (HAS_INLINE)
+		return _map == _inline.map;
+	else
+		return false;
 }
 
-template<typename _Ty>
-inline Deque<_Ty>::Deque(const Deque& other)
-	: Deque()
+//    offset  INLINE_SIZE   ,    - 
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::inline_back_full() const noexcept
 {
-	for (const auto& elem : other)
-		push_back(elem);
+	if constexpr (HAS_INLINE)
+		return _finish_offset == INLINE_SIZE && is_inline();
+	else
+		return false;
 }
 
-template<typename _Ty>
-inline Deque<_Ty>::Deque(Deque&& other) noexcept
-	: _map(other._map)
-	, _map_size(other._map_size)
-	, _start_block(other._start_block), _start_offset(other._start_offset)
-	, _finish_block(other._finish_block), _finish_offset(other._finish_offset)
+//       :   
+//   ,      
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline std::size_t Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::inline_room(std::size_t in_place) const noexcept
 {
-	other._map = nullptr;
-	other._map_size = 0;
-	other._start_block = 0;
-	other._start_offset = 0;
-	other._finish_block = 0;
-	other._finish_offset = 0;
+	if (_map == nullptr)
+		return INLINE_SIZE;
+	if constexpr (std::is_nothrow_move_constructible_v<_Ty>)
+		return INLINE_SIZE - _size;
+	else
+		return in_place;
 }
 
-template<typename _Ty>
-inline Deque<_Ty>::~Deque()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::enter_inline(std::size_t offset) noexcept
 {
-	clear();
-	destroy_all();
+	if constexpr (HAS_INLINE)
+	{
+		_inline.map[0] = reinterpret_cast<Block>(_inline.elements);
+		_map = _inline.map;
+		_map_size = 1;
+		_start_block = _finish_block = 0;
+		_start_offset = _finish_offset = offset;
+	}
 }
 
-template<typename _Ty>
-Deque<_Ty>& Deque<_Ty>::operator=(const Deque& other)
+//     ,      count;
+// false,       
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::make_inline_room(std::size_t count, bool at_front)
 {
-	if (this == &other)
-		return *this;
+	if constexpr (HAS_INLINE && std::is_nothrow_move_constructible_v<_Ty>)
+	{
+		if (_size + count > INLINE_SIZE)
+			return false;
 
-	destroy_all();
-	allocate_map(other._map_size);
+		size_type slack = INLINE_SIZE - _size - count;
+		size_type new_start = slack / 2 + (at_front ? count : 0);
+		Block block = _map[0];
 
-	for (size_type i = 0; i < other._size; ++i)
-		push_back(other[i]);
+		if (new_start < _start_offset)
+		{
+			for (size_type i = 0; i < _size; ++i)
+			{
+				_Alty_traits::construct(_alloc, block + new_start + i, std::move(block[_start_offset + i]));
+				_Alty_traits::destroy(_alloc, block + _start_offset + i);
+			}
+		}
+		else if (new_start > _start_offset)
+		{
+			for (size_type i = _size; i-- > 0;)
+			{
+				_Alty_traits::construct(_alloc, block + new_start + i, std::move(block[_start_offset + i]));
+				_Alty_traits::destroy(_alloc, block + _start_offset + i);
+			}
+		}
 
-	return *this;
+		_start_offset = new_start;
+		_finish_offset = new_start + _size;
+		return true;
+	}
+	else
+		return false;
 }
 
-template<typename _Ty>
-Deque<_Ty>& Deque<_Ty>::operator=(Deque&& other) noexcept
+//  :      
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::leave_inline()
 {
-	if (this != &other) 
+	if constexpr (HAS_INLINE)
 	{
-		//   
-		clear();
-		destroy_all();
+		Map map = create_map(MIN_MAP_SIZE);
+		Block block = nullptr;
+		size_type start = (BLOCK_SIZE - _size) / 2;
+		size_type built = 0;
 
-		//  
-		_map = other._map;
-		_map_size = other._map_size;
-		_start_block = other._start_block;
-		_start_offset = other._start_offset;
-		_finish_block = other._finish_block;
-		_finish_offset = other._finish_offset;
-		_size = other._size;
+		try
+		{
+			block = acquire_block();
+			for (; built < _size; ++built)
+				_Alty_traits::construct(_alloc, block + start + built, std::move_if_noexcept(_map[0][_start_offset + built]));
+		}
+		catch (...)
+		{
+			if (block)
+			{
+				destroy_range(block + start, built);
+				release_block(block);
+			}
+			delete_map(map, MIN_MAP_SIZE);
+			throw;
+		}
+
+		destroy_range(_map[0] + _start_offset, _size);
 
-		//  
-		other._map = nullptr;
-		other._map_size = 0;
-		other._start_block = other._start_offset = 0;
-		other._finish_block = other._finish_offset = 0;
-		other._size = 0;
+		size_type center = MIN_MAP_SIZE / 2;
+		map[center] = block;
+		_map = map;
+		_map_size = MIN_MAP_SIZE;
+		_start_block = _finish_block = center;
+		_start_offset = start;
+		_finish_offset = start + _size;
+		if (_finish_offset == BLOCK_SIZE)
+		{
+			++_finish_block;
+			_finish_offset = 0;
+		}
 	}
-	return *this;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::assign(std::initializer_list<value_type> init)
+//     :    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::steal_inline(Deque& other) noexcept(NOTHROW_STEAL)
 {
-	clear();
-	for (const auto& elem : init)
-		push_back(elem);
+	if constexpr (HAS_INLINE)
+	{
+		enter_inline(other._start_offset);
+		Block source = other._map[0];
+		Block target = _map[0];
+
+		for (size_type i = _start_offset; i < other._finish_offset; ++i)
+		{
+			_Alty_traits::construct(_alloc, target + i, std::move(source[i]));
+			_Alty_traits::destroy(other._alloc, source + i);
+		}
+		_finish_offset = other._finish_offset;
+		_size = other._size;
+	}
 }
 
-template<typename _Ty>
-void Deque<_Ty>::assign(size_type count, const_reference value)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::recycle_block(std::size_t index)
 {
-	clear();
-	for (size_type i = 0; i < count; ++i)
-		push_back(value);
+	if (is_inline())
+		return;
+
+	release_block(_map[index]);
+	_map[index] = nullptr;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::push_back(const_reference value)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Block Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::acquire_block()
 {
-	if (_finish_offset == BLOCK_SIZE)
+	if (_spare == nullptr)
 	{
-		if (_finish_block + 1 >= _map_size)
-			reallocate_map(false);
-
-		if (_map[_finish_block + 1] == nullptr)
-			allocate_block(_finish_block + 1);
-
-		++_finish_block;
-		_finish_offset = 0;
+		Block block = _Alty_traits::allocate(_alloc, BLOCK_SIZE);
+		++_block_count;
+		_stats.block_allocated(_block_count);
+		return block;
 	}
 
-	::new (static_cast<void*>(_map[_finish_block] + _finish_offset)) value_type(value);
-	++_finish_offset;
-	++_size;
+	Block block = _spare;
+	std::memcpy(&_spare, static_cast<void*>(block), sizeof(Block));
+	--_spare_count;
+	return block;
 }
 
-template<typename _Ty>
-void Deque<_Ty>::push_front(const_reference value)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::release_block(Block block)
 {
-	if (_start_offset == 0)
+	if constexpr (CAN_CACHE_BLOCKS)
 	{
-		if (_start_block == 0)
-			reallocate_map(true);
-
-		if (_map[_start_block - 1] == nullptr)
-			allocate_block(_start_block - 1);
-
-		--_start_block;
-		_start_offset = BLOCK_SIZE;
+		if (_spare_count < _spare_limit)
+		{
+			std::memcpy(static_cast<void*>(block), &_spare, sizeof(Block));
+			_spare = block;
+			++_spare_count;
+			return;
+		}
 	}
+	_Alty_traits::deallocate(_alloc, block, BLOCK_SIZE);
+	--_block_count;
+	_stats.block_freed();
+}
 
-	--_start_offset;
-	::new (static_cast<void*>(_map[_start_block] + _start_offset)) value_type(value);
-	++_size;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::release_spare_blocks(std::size_t keep)
+{
+	while (_spare_count > keep)
+	{
+		Block block = _spare;
+		std::memcpy(&_spare, static_cast<void*>(block), sizeof(Block));
+		--_spare_count;
+		_Alty_traits::deallocate(_alloc, block, BLOCK_SIZE);
+		--_block_count;
+		_stats.block_freed();
+	}
 }
 
-template<typename _Ty>
-void Deque<_Ty>::pop_back()
+//       ,   .
+//     ,    :  
+//  _start_block  _finish_block
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::release_reserve_blocks()
 {
-	if (empty()) 
-		throw std::out_of_range("Deque is empty!");
+	size_type first = _start_block;
+	size_type last = _finish_block + (_finish_offset != 0 ? 1 : 0);
 
-	if (_finish_offset == 0) 
+	for (size_type i = 0; i < _map_size; ++i)
 	{
-		//    
-		_finish_block--;
-		_finish_offset = BLOCK_SIZE - 1;
+		if (_map[i] && (i < first || i >= last))
+			deallocate_block(i);
 	}
-	else
-		--_finish_offset;
+}
 
-	std::destroy_at(block_pointer(_finish_block, _finish_offset));
-	--_size;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline std::size_t Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::live_blocks() const noexcept
+{
+	if (_size == 0)
+		return 0;
+	return _finish_block - _start_block + (_finish_offset != 0 ? 1 : 0);
 }
 
-template<typename _Ty>
-void Deque<_Ty>::pop_front()
+//     ,     
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::note_block_drained()
 {
-	if (empty()) 
-		throw std::out_of_range("Deque is empty!");
+	if (_shrink_after == 0 || _keep_reserve)
+		return;
 
-	std::destroy_at(block_pointer(_start_block, _start_offset));
+	//     
+	if (_block_count > 2 * live_blocks() + _spare_limit)
+	{
+		if (++_low_occupancy_drains >= _shrink_after)
+		{
+			release_reserve_blocks();
+			_low_occupancy_drains = 0;
+		}
+	}
+	else
+		_low_occupancy_drains = 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::destroy_range(_Ty* first, std::size_t count)
+{
+	if constexpr (!TRIVIAL_DESTROY)
+	{
+		for (size_type i = 0; i < count; ++i)
+			_Alty_traits::destroy(_alloc, first + i);
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::destroy_elements()
+{
+	size_type block = _start_block;
+	size_type offset = _start_offset;
+
+	for (size_type left = _size; left > 0;)
+	{
+		size_type step = std::min(left, BLOCK_SIZE - offset);
+		destroy_range(block_pointer(block, offset), step);
+		left -= step;
+		offset = 0;
+		++block;
+	}
+	_size = 0;
+	_finish_block = _start_block;
+	_start_offset = _finish_offset = 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::erase_back(std::size_t count)
+{
+	size_type block = _finish_block;
+	size_type offset = _finish_offset;
+
+	for (size_type left = count; left > 0;)
+	{
+		if (offset == 0)
+		{
+			--block;
+			offset = BLOCK_SIZE;
+		}
+		size_type step = std::min(left, offset);
+		offset -= step;
+		destroy_range(block_pointer(block, offset), step);
+		left -= step;
+	}
+
+	_finish_block = block;
+	_finish_offset = offset;
+	_size -= count;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::erase_front(std::size_t count)
+{
+	for (size_type left = count; left > 0;)
+	{
+		size_type step = std::min(left, BLOCK_SIZE - _start_offset);
+		destroy_range(block_pointer(_start_block, _start_offset), step);
+		left -= step;
+
+		_start_offset += step;
+		if (_start_offset == BLOCK_SIZE)
+		{
+			recycle_block(_start_block);
+			++_start_block;
+			_start_offset = 0;
+		}
+	}
+	_size -= count;
+}
+
+//  ,   ,   last_block
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::release_back_blocks(std::size_t last_block)
+{
+	if (_keep_reserve)
+		return;
+
+	size_type first = _finish_block + (_finish_offset != 0 ? 1 : 0);
+	last_block = std::min(last_block, _map_size - 1);
+
+	for (size_type i = first; i <= last_block; ++i)
+	{
+		if (_map[i])
+			recycle_block(i);
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::destroy_all()
+{
+	if (_map)
+	{
+		destroy_elements();
+
+		//    [_start_block, _finish_block]    
+		for (size_type i = 0; i < _map_size; ++i)
+		{
+			if (_map[i])
+				deallocate_block(i);
+		}
+
+		if (!is_inline())
+			delete_map(_map, _map_size);
+		_map = nullptr;
+	}
+	release_spare_blocks(0);
+	_map_size = 0;
+	_size = 0;
+	_start_block = _start_offset = _finish_block = _finish_offset = 0;
+	_keep_reserve = false;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::steal(Deque& other) noexcept(NOTHROW_STEAL)
+{
+	if (other.is_inline())
+		steal_inline(other);
+	else
+	{
+		_map = other._map;
+		_map_size = other._map_size;
+		_start_block = other._start_block;
+		_start_offset = other._start_offset;
+		_finish_block = other._finish_block;
+		_finish_offset = other._finish_offset;
+		_size = other._size;
+	}
+	_spare = other._spare;
+	_spare_count = other._spare_count;
+	_spare_limit = other._spare_limit;
+	_block_count = other._block_count;
+	_shrink_after = other._shrink_after;
+	_low_occupancy_drains = other._low_occupancy_drains;
+	_keep_reserve = other._keep_reserve;
+	//        
+	_stats = std::move(other._stats);
+
+	other._map = nullptr;
+	other._map_size = 0;
+	other._start_block = other._start_offset = 0;
+	other._finish_block = other._finish_offset = 0;
+	other._size = 0;
+	other._spare = nullptr;
+	other._spare_count = 0;
+	other._block_count = 0;
+	other._low_occupancy_drains = 0;
+	other._keep_reserve = false;
+	other._stats = _Stats();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _It>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::append_n(_It first, std::size_t count)
+{
+	reserve_back_blocks(count);
+
+	while (count > 0)
+	{
+		size_type chunk = std::min(count, BLOCK_SIZE - _finish_offset);
+		pointer dst = _map[_finish_block] + _finish_offset;
+
+		if constexpr (TRIVIAL_COPY && std::is_same_v<_It, const_iterator>)
+		{
+			//   :       
+			chunk = std::min(chunk, BLOCK_SIZE - first._offset);
+			std::memcpy(static_cast<void*>(dst), first._map_ptr[first._block] + first._offset, chunk * sizeof(_Ty));
+			first += static_cast<difference_type>(chunk);
+			_finish_offset += chunk;
+			_size += chunk;
+		}
+		else if constexpr (TRIVIAL_COPY && std::contiguous_iterator<_It>)
+		{
+			std::memcpy(static_cast<void*>(dst), std::to_address(first), chunk * sizeof(_Ty));
+			first += chunk;
+			_finish_offset += chunk;
+			_size += chunk;
+		}
+		else
+		{
+			for (size_type i = 0; i < chunk; ++i, ++first)
+			{
+				_Alty_traits::construct(_alloc, dst + i, *first);
+				++_finish_offset;
+				++_size;
+			}
+		}
+
+		if (_finish_offset == BLOCK_SIZE)
+		{
+			++_finish_block;
+			_finish_offset = 0;
+		}
+		count -= chunk;
+	}
+	_stats.size_grew(_size);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _It>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::prepend_n(_It first, std::size_t count)
+{
+	reserve_front_blocks(count);
+
+	//     _start,     
+	iterator new_start = begin() - static_cast<difference_type>(count);
+	size_type block = new_start._block;
+	size_type offset = new_start._offset;
+	size_type left = count;
+
+	try
+	{
+		while (left > 0)
+		{
+			size_type chunk = std::min(left, BLOCK_SIZE - offset);
+			pointer dst = _map[block] + offset;
+
+			if constexpr (TRIVIAL_COPY && std::is_same_v<_It, const_iterator>)
+			{
+				chunk = std::min(chunk, BLOCK_SIZE - first._offset);
+				std::memcpy(static_cast<void*>(dst), first._map_ptr[first._block] + first._offset, chunk * sizeof(_Ty));
+				first += static_cast<difference_type>(chunk);
+				offset += chunk;
+				left -= chunk;
+			}
+			else if constexpr (TRIVIAL_COPY && std::contiguous_iterator<_It>)
+			{
+				std::memcpy(static_cast<void*>(dst), std::to_address(first), chunk * sizeof(_Ty));
+				first += chunk;
+				offset += chunk;
+				left -= chunk;
+			}
+			else
+			{
+				for (size_type i = 0; i < chunk; ++i, ++first)
+				{
+					_Alty_traits::construct(_alloc, dst + i, *first);
+					++offset;
+					--left;
+				}
+			}
+
+			if (offset == BLOCK_SIZE)
+			{
+				++block;
+				offset = 0;
+			}
+		}
+	}
+	catch (...)
+	{
+		for (iterator it = new_start; it != iterator(_map, block, offset); ++it)
+			_Alty_traits::destroy(_alloc, &*it);
+		throw;
+	}
+
+	_start_block = new_start._block;
+	_start_offset = new_start._offset;
+	_size += count;
+	_stats.size_grew(_size);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::append_fill(std::size_t count, const _Ty& value)
+{
+	//       ,    value
+	if (is_inline() && _finish_offset + count > INLINE_SIZE)
+	{
+		value_type copy(value);
+		reserve_back_blocks(count);
+		append_fill(count, copy);
+		return;
+	}
+
+	reserve_back_blocks(count);
+
+	while (count > 0)
+	{
+		size_type chunk = std::min(count, BLOCK_SIZE - _finish_offset);
+		pointer dst = _map[_finish_block] + _finish_offset;
+
+		if constexpr (TRIVIAL_COPY)
+		{
+			std::uninitialized_fill_n(dst, chunk, value);
+			_finish_offset += chunk;
+			_size += chunk;
+		}
+		else
+		{
+			for (size_type i = 0; i < chunk; ++i)
+			{
+				_Alty_traits::construct(_alloc, dst + i, value);
+				++_finish_offset;
+				++_size;
+			}
+		}
+
+		if (_finish_offset == BLOCK_SIZE)
+		{
+			++_finish_block;
+			_finish_offset = 0;
+		}
+		count -= chunk;
+	}
+	_stats.size_grew(_size);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline _Ty* Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::block_pointer(std::size_t block, std::size_t offset)
+{
+	return _map[block] + offset;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline const _Ty* Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::block_pointer(std::size_t block, std::size_t offset) const
+{
+	return _map[block] + offset;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline _Ty* Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::element_pointer(std::size_t index)
+{
+	std::size_t pos = _start_offset + index;
+	return block_pointer(_start_block + (pos >> BLOCK_SHIFT), pos & BLOCK_MASK);
+}
+
+//  [first, last)   ,    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::move_elements(std::size_t first, std::size_t last, std::size_t dest)
+{
+	_stats.elements_shifted(last - first);
+	while (first != last)
+	{
+		std::size_t src_room = BLOCK_SIZE - ((_start_offset + first) & BLOCK_MASK);
+		std::size_t dest_room = BLOCK_SIZE - ((_start_offset + dest) & BLOCK_MASK);
+		std::size_t chunk = std::min({ last - first, src_room, dest_room });
+
+		_Ty* src = element_pointer(first);
+		std::move(src, src + chunk, element_pointer(dest));
+		first += chunk;
+		dest += chunk;
+	}
+}
+
+//  [first, last)   ,   
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::move_elements_backward(std::size_t first, std::size_t last, std::size_t dest_last)
+{
+	_stats.elements_shifted(last - first);
+	while (first != last)
+	{
+		std::size_t src_room = ((_start_offset + last - 1) & BLOCK_MASK) + 1;
+		std::size_t dest_room = ((_start_offset + dest_last - 1) & BLOCK_MASK) + 1;
+		std::size_t chunk = std::min({ last - first, src_room, dest_room });
+
+		_Ty* src_end = element_pointer(last - 1) + 1;
+		std::move_backward(src_end - chunk, src_end, element_pointer(dest_last - 1) + 1);
+		last -= chunk;
+		dest_last -= chunk;
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque() noexcept(noexcept(allocator_type()))
+	: Deque(allocator_type())
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(const allocator_type& alloc) noexcept
+	: _alloc(alloc)
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(size_type count, const allocator_type& alloc)
+	: Deque(alloc)
+{
+	resize(count);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(size_type count, const_reference value, const allocator_type& alloc)
+	: Deque(alloc)
+{
+	append_fill(count, value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(std::initializer_list<value_type> init, const allocator_type& alloc)
+	: Deque(alloc)
+{
+	append_n(init.begin(), init.size());
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(const Deque& other)
+	: Deque(other, _Alty_traits::select_on_container_copy_construction(other._alloc))
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(const Deque& other, const allocator_type& alloc)
+	: Deque(alloc)
+{
+	_spare_limit = other._spare_limit;
+	_shrink_after = other._shrink_after;
+	append_n(other.begin(), other._size);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(Deque&& other) noexcept(NOTHROW_STEAL)
+	: _alloc(std::move(other._alloc))
+{
+	steal(other);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Deque(Deque&& other, const allocator_type& alloc)
+	: _alloc(alloc)
+{
+	if constexpr (_Alty_traits::is_always_equal::value)
+		steal(other);
+	else if (_alloc == other._alloc)
+		steal(other);
+	else
+	{
+		//  :   ,  
+		for (auto& elem : other)
+			emplace_back(std::move(elem));
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::~Deque()
+{
+	destroy_all();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator=(const Deque& other)
+{
+	if (this == &other)
+		return *this;
+
+	if constexpr (_Alty_traits::propagate_on_container_copy_assignment::value)
+	{
+		if (_alloc != other._alloc)
+			destroy_all(); //    
+		_alloc = other._alloc;
+	}
+
+	//        
+	destroy_elements();
+	append_n(other.begin(), other._size);
+	return *this;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator=(Deque&& other) noexcept(NOTHROW_STEAL
+	&& (_Alty_traits::propagate_on_container_move_assignment::value
+		|| _Alty_traits::is_always_equal::value))
+{
+	if (this == &other)
+		return *this;
+
+	if constexpr (_Alty_traits::propagate_on_container_move_assignment::value)
+	{
+		//   
+		destroy_all();
+		_alloc = std::move(other._alloc);
+		//  
+		steal(other);
+	}
+	else if (_Alty_traits::is_always_equal::value || _alloc == other._alloc)
+	{
+		destroy_all();
+		steal(other);
+	}
+	else
+	{
+		clear();
+		for (auto& elem : other)
+			emplace_back(std::move(elem));
+		other.clear();
+	}
+	return *this;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::allocator_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::get_allocator() const noexcept
+{
+	return allocator_type(_alloc);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::assign(std::initializer_list<value_type> init)
+{
+	destroy_elements();
+	append_n(init.begin(), init.size());
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::assign(size_type count, const_reference value)
+{
+	destroy_elements();
+	append_fill(count, value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::push_back(const_reference value)
+{
+	emplace_back(value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::push_back(value_type&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::push_front(const_reference value)
+{
+	emplace_front(value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::push_front(value_type&& value)
+{
+	emplace_front(std::move(value));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::pop_back()
+{
+	if (empty()) 
+		throw std::out_of_range("Deque is empty!");
+
+	unchecked_pop_back();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::pop_front()
+{
+	if (empty()) 
+		throw std::out_of_range("Deque is empty!");
+
+	unchecked_pop_front();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::unchecked_pop_back() noexcept
+{
+	assert(!empty());
+
+	if (_finish_offset == 0) 
+	{
+		//      ,  push_front   ;
+		//    
+		if (!_keep_reserve && _finish_block < _map_size && _map[_finish_block])
+			recycle_block(_finish_block);
+
+		//    
+		_finish_block--;
+		_finish_offset = BLOCK_SIZE - 1;
+		_Alty_traits::destroy(_alloc, block_pointer(_finish_block, _finish_offset));
+		--_size;
+		note_block_drained();
+		return;
+	}
+
+	--_finish_offset;
+	_Alty_traits::destroy(_alloc, block_pointer(_finish_block, _finish_offset));
+	--_size;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::unchecked_pop_front() noexcept
+{
+	assert(!empty());
+
+	_Alty_traits::destroy(_alloc, block_pointer(_start_block, _start_offset));
+	--_size;
 
 	if (++_start_offset == BLOCK_SIZE) 
 	{
-		deallocate_block(_start_block);
+		recycle_block(_start_block); //     push_back
 		++_start_block;
 		_start_offset = 0;
+		note_block_drained();
 	}
+}
 
-	--_size;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::pop_back_n(size_type count)
+{
+	if (count > _size)
+		throw std::out_of_range("Deque has fewer elements than requested!");
+	if (count == 0)
+		return;
+
+	size_type last_block = _finish_block;
+	erase_back(count);
+	release_back_blocks(last_block);
+	note_block_drained();
 }
 
-template<typename _Ty>
-template<typename ...Args>
-typename Deque<_Ty>::reference Deque<_Ty>::emplace_back(Args && ...args)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::pop_front_n(size_type count)
+{
+	if (count > _size)
+		throw std::out_of_range("Deque has fewer elements than requested!");
+	if (count == 0)
+		return;
+
+	erase_front(count);
+	note_block_drained();
+}
+
+//     ,  .  
+//  ,      ,   
+//     (  -    )
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _OutIt>
+_OutIt Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::drain_front(size_type count, _OutIt dest)
 {
-	if (_finish_offset == BLOCK_SIZE)
+	if (count > _size)
+		throw std::out_of_range("Deque has fewer elements than requested!");
+
+	while (count > 0)
 	{
-		if (_finish_block + 1 >= _map_size)
-			reallocate_map(false);
+		size_type step = std::min(count, BLOCK_SIZE - _start_offset);
+		_Ty* first = block_pointer(_start_block, _start_offset);
+		dest = std::move(first, first + step, dest);
+		erase_front(step);
+		count -= step;
+	}
+	note_block_drained();
+	return dest;
+}
 
-		if (_map[_finish_block + 1] == nullptr)
-			allocate_block(_finish_block + 1);
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename ...Args>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::emplace_back(Args && ...args)
+{
+	if (_finish_offset == 0 || inline_back_full())
+	{
+		//    ,  args -    
+		if (inline_back_full())
+		{
+			value_type value(std::forward<Args>(args)...);
+			prepare_back_block();
+			return emplace_back(std::move(value));
+		}
+		prepare_back_block();
+	}
 
+	pointer ptr = _map[_finish_block] + _finish_offset;
+	_Alty_traits::construct(_alloc, ptr, std::forward<Args>(args)...);
+	if (++_finish_offset == BLOCK_SIZE)
+	{
 		++_finish_block;
 		_finish_offset = 0;
 	}
-
-	::new (static_cast<void*>(_map[_finish_block] + _finish_offset)) value_type(std::forward<Args>(args)...);
 	++_size;
-	return _map[_finish_block][_finish_offset++];
+	_stats.size_grew(_size);
+	return *ptr;
 }
 
-template<typename _Ty>
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
 template<typename ...Args>
-typename Deque<_Ty>::reference Deque<_Ty>::emplace_front(Args && ...args)
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::emplace_front(Args && ...args)
 {
 	if (_start_offset == 0)
 	{
-		if (_start_block == 0)
-			reallocate_map(true);
-
-		if (_map[_start_block - 1] == nullptr)
-			allocate_block(_start_block - 1);
-
-		--_start_block;
-		_start_offset = BLOCK_SIZE;
+		if (is_inline())
+		{
+			value_type value(std::forward<Args>(args)...);
+			prepare_front_block();
+			return emplace_front(std::move(value));
+		}
+		prepare_front_block();
 	}
 
+	_Alty_traits::construct(_alloc, _map[_start_block] + _start_offset - 1, std::forward<Args>(args)...);
 	--_start_offset;
-	::new (static_cast<void*>(_map[_start_block] + _start_offset)) value_type(std::forward<Args>(args)...);
 	++_size;
+	_stats.size_grew(_size);
 	return _map[_start_block][_start_offset];
 }
 
-template<typename _Ty>
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
 template<typename ...Args>
-typename Deque<_Ty>::iterator Deque<_Ty>::emplace(iterator pos, Args && ...args)
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::emplace(iterator pos, Args && ...args)
 {
 	size_type index = static_cast<size_type>(pos - begin());
+	if (index == _size)
+	{
+		emplace_back(std::forward<Args>(args)...);
+		return end() - 1;
+	}
+	if (index == 0)
+	{
+		emplace_front(std::forward<Args>(args)...);
+		return begin();
+	}
+
+	//       
+	value_type value(std::forward<Args>(args)...);
+
+	//   ,  
+	if (index < _size / 2)
+	{
+		emplace_front(std::move(front()));
+		move_elements(2, index + 1, 1);
+	}
+	else
+	{
+		emplace_back(std::move(back()));
+		move_elements_backward(index, _size - 2, _size - 1);
+	}
+
+	*element_pointer(index) = std::move(value);
+	return begin() + index;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::front()
+{
+	return _map[_start_block][_start_offset];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::front() const
+{
+	return _map[_start_block][_start_offset];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::back()
+{
+	size_type ob = _finish_offset == 0 ? _finish_block - 1 : _finish_block;
+	size_type oo = _finish_offset == 0 ? BLOCK_SIZE - 1 : _finish_offset - 1;
+	return _map[ob][oo];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::back() const
+{
+	size_type ob = _finish_offset == 0 ? _finish_block - 1 : _finish_block;
+	size_type oo = _finish_offset == 0 ? BLOCK_SIZE - 1 : _finish_offset - 1;
+	return _map[ob][oo];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::clear()
+{
+	if (empty())
+		return;
+
+	destroy_elements();
+
+	//     ,     
+	if (_keep_reserve)
+		return;
+
+	//   ,    :    
+	//   
+	size_type center = _map_size / 2;
+	if (_map[center] == nullptr)
+		std::swap(_map[center], _map[_start_block]);
 
-	if (_size == capacity())
-		resize_map(_map_size * 2);
+	for (size_type i = 0; i < _map_size; ++i)
+	{
+		if (_map[i] && i != center)
+			recycle_block(i);
+	}
+
+	_start_block = _finish_block = center;
+	_start_offset = _finish_offset = 0;
+	_size = 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator[](size_type index)
+{
+	size_type offset = _start_offset + index;
+	return _map[_start_block + (offset >> BLOCK_SHIFT)][offset & BLOCK_MASK];
+}
 
-	for (size_type i = _size; i > index; --i)
-		(*this)[i] = std::move((*this)[i - 1]);
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator[](size_type index) const
+{
+	size_type offset = _start_offset + index;
+	return _map[_start_block + (offset >> BLOCK_SHIFT)][offset & BLOCK_MASK];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::at(size_type index)
+{
+	if (index >= _size)
+		throw std::out_of_range("at() out of range");
+	return (*this)[index];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::at(size_type index) const
+{
+	if (index >= _size)
+		throw std::out_of_range("at() out of range");
+	return (*this)[index];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+constexpr typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::block_size() noexcept
+{
+	return BLOCK_SIZE;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::capacity() const noexcept
+{
+	//       ,    
+	if (_map == nullptr || is_inline())
+		return INLINE_SIZE;
+	return _size + capacity_front() + capacity_back();
+}
+
+//  push_front    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::capacity_front() const noexcept
+{
+	if constexpr (HAS_INLINE)
+	{
+		if (_map == nullptr || is_inline())
+			return inline_room(_start_offset);
+	}
+
+	size_type result = _start_offset;
+	for (size_type i = _start_block; i-- > 0 && _map[i];)
+		result += BLOCK_SIZE;
+	return result;
+}
+
+//  push_back    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::capacity_back() const noexcept
+{
+	if constexpr (HAS_INLINE)
+	{
+		if (_map == nullptr || is_inline())
+			return inline_room(INLINE_SIZE - _finish_offset);
+	}
+
+	if (_finish_block >= _map_size || _map[_finish_block] == nullptr)
+		return 0;
+
+	size_type result = BLOCK_SIZE - _finish_offset;
+	for (size_type i = _finish_block + 1; i < _map_size && _map[i]; ++i)
+		result += BLOCK_SIZE;
+	return result;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reserve_front(size_type count)
+{
+	reserve_front_blocks(count);
+	_keep_reserve = true;
+}
 
-	size_type block = index / BLOCK_SIZE;
-	size_type offset = index % BLOCK_SIZE;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reserve_back(size_type count)
+{
+	reserve_back_blocks(count);
+	_keep_reserve = true;
+}
 
-	_Ty* ptr = &_map[block][offset];
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size() const
+{
+	return _size;
+}
 
-	ptr->~_Ty();
-	new (ptr) value_type(std::forward<Args>(args)...);
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::empty() const
+{
+	return _size == 0;
+}
 
-	++_size;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::spare_blocks() const noexcept
+{
+	return _spare_count;
+}
 
-	return iterator(_map, block, offset);
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+_Stats Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::stats() const
+{
+	_Stats snapshot = _stats;
+	if constexpr (requires { snapshot.bytes_reserved = std::size_t(); snapshot.bytes_live = std::size_t(); })
+	{
+		snapshot.bytes_reserved = _block_count * BLOCK_SIZE * sizeof(_Ty);
+		if (!is_inline())
+			snapshot.bytes_reserved += _map_size * sizeof(Block);
+		snapshot.bytes_live = _size * sizeof(_Ty);
+	}
+	return snapshot;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reference Deque<_Ty>::front()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Memory_Usage Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::memory_usage() const noexcept
 {
-	return _map[_start_block][_start_offset];
+	Memory_Usage usage;
+	if (!is_inline())
+		usage.map_bytes = _map_size * sizeof(Block);
+	usage.block_bytes = _block_count * BLOCK_SIZE * sizeof(_Ty);
+	usage.spare_bytes = _spare_count * BLOCK_SIZE * sizeof(_Ty);
+	if constexpr (HAS_INLINE)
+		usage.inline_bytes = INLINE_SIZE * sizeof(_Ty);
+	usage.live_bytes = _size * sizeof(_Ty);
+	if (_map == nullptr || is_inline())
+	{
+		// capacity_front/back    ,    
+		usage.front_slack_bytes = (_map ? _start_offset : 0) * sizeof(_Ty);
+		usage.back_slack_bytes = (INLINE_SIZE - (_map ? _finish_offset : 0)) * sizeof(_Ty);
+	}
+	else
+	{
+		usage.front_slack_bytes = capacity_front() * sizeof(_Ty);
+		usage.back_slack_bytes = capacity_back() * sizeof(_Ty);
+	}
+	return usage;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reference Deque<_Ty>::front() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Fn>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::for_each_block(_Fn&& func) const
 {
-	return _map[_start_block][_start_offset];
+	const size_type block_capacity = is_inline() ? INLINE_SIZE : BLOCK_SIZE;
+	for (size_type i = 0; i < _map_size; ++i)
+	{
+		if (_map[i] == nullptr)
+			continue;
+
+		size_type live_first = 0;
+		size_type live_last = 0;
+		if (_size != 0 && i >= _start_block && i <= _finish_block)
+		{
+			live_first = i == _start_block ? _start_offset : 0;
+			live_last = i == _finish_block ? _finish_offset : block_capacity;
+		}
+		func(const_cast<const _Ty*>(_map[i]), block_capacity, live_first, live_last);
+	}
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reference Deque<_Ty>::back()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::spare_block_limit() const noexcept
 {
-	size_type ob = _finish_offset == 0 ? _finish_block - 1 : _finish_block;
-	size_type oo = _finish_offset == 0 ? BLOCK_SIZE - 1 : _finish_offset - 1;
-	return _map[ob][oo];
+	return _spare_limit;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reference Deque<_Ty>::back() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::set_spare_block_limit(size_type limit)
 {
-	size_type ob = _finish_offset == 0 ? _finish_block - 1 : _finish_block;
-	size_type oo = _finish_offset == 0 ? BLOCK_SIZE - 1 : _finish_offset - 1;
-	return _map[ob][oo];
+	_spare_limit = limit;
+	release_spare_blocks(limit);
 }
 
-template<typename _Ty>
-inline void Deque<_Ty>::clear()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::shrink_to_fit()
 {
-	if (empty())
+	_low_occupancy_drains = 0;
+	_keep_reserve = false;
+	if (_map == nullptr)
+	{
+		release_spare_blocks(0);
 		return;
+	}
 
-	size_type total = _size;
-	size_type block = _start_block;
-	size_type offset = _start_offset;
+	if (_size == 0)
+	{
+		//       
+		destroy_all();
+		return;
+	}
 
-	for (size_type i = 0; i < total; ++i)
+	if constexpr (HAS_INLINE && std::is_nothrow_move_constructible_v<_Ty>)
 	{
-		_map[block][offset].~_Ty();
-		if (++offset == BLOCK_SIZE)
+		//    :      
+		if (!is_inline() && _size <= INLINE_SIZE)
 		{
-			offset = 0;
-			++block;
+			Deque blocks(std::move(*this));
+			reserve_back_blocks(blocks._size);
+			for (auto& elem : blocks)
+				emplace_back(std::move(elem));
+
+			//        
+			blocks.destroy_all();
+			_stats = std::move(blocks._stats);
+			return;
 		}
 	}
 
-	for (size_type i = 0; i < _map_size; ++i)
-	{
-		if (_map[i])
-			deallocate_block(i);
-	}
+	release_reserve_blocks();
+	release_spare_blocks(0);
 
-	size_type center = _map_size / 2;
-	allocate_map(center);
+	//      (  _finish_block)
+	size_type new_map_size = _finish_block - _start_block + 1;
+	if (new_map_size >= _map_size)
+		return;
 
-	_start_block = _finish_block = center;
-	_start_offset = _finish_offset = 0;
-	_size = 0;
+	Map new_map = create_map(new_map_size);
+	std::copy(_map + _start_block, _map + std::min(_finish_block + 1, _map_size), new_map);
+	delete_map(_map, _map_size);
+
+	_map = new_map;
+	_map_size = new_map_size;
+	_finish_block -= _start_block;
+	_start_block = 0;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reference Deque<_Ty>::operator[](size_type index)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::auto_shrink() const noexcept
 {
-	size_type offset = _start_offset + index;
-	size_type block = _start_block + offset / BLOCK_SIZE;
-	size_type block_offset = offset % BLOCK_SIZE;
-	return _map[block][block_offset];
+	return _shrink_after;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reference Deque<_Ty>::operator[](size_type index) const
+// 0 ;     drains   ,
+//      
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::set_auto_shrink(size_type drains)
 {
-	size_type offset = _start_offset + index;
-	size_type block = _start_block + offset / BLOCK_SIZE;
-	size_type block_offset = offset % BLOCK_SIZE;
-	return _map[block][block_offset];
+	_shrink_after = drains;
+	_low_occupancy_drains = 0;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reference Deque<_Ty>::at(size_type index)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::resize(size_type new_size)
 {
-	if (index >= _size)
-		throw std::out_of_range("at() out of range");
-	return (*this)[index];
+	if (new_size < _size)
+		erase_back(_size - new_size);
+	else if (new_size > _size)
+	{
+		reserve_back_blocks(new_size - _size);
+		while (_size < new_size)
+			emplace_back();
+	}
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reference Deque<_Ty>::at(size_type index) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::resize(size_type new_size, const_reference value)
 {
-	if (index >= _size)
-		throw std::out_of_range("at() out of range");
-	return (*this)[index];
+	if (new_size < _size)
+		erase_back(_size - new_size);
+	else if (new_size > _size)
+		append_fill(new_size - _size, value);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::size_type Deque<_Ty>::capacity() const noexcept
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::swap(Deque& other)
 {
-	return _map_size * BLOCK_SIZE;
+	//     
+	if (is_inline() || other.is_inline())
+	{
+		Deque tmp(std::move(other));
+		other = std::move(*this);
+		*this = std::move(tmp);
+		return;
+	}
+
+	if constexpr (_Alty_traits::propagate_on_container_swap::value)
+	{
+		using std::swap;
+		swap(_alloc, other._alloc);
+	}
+	else
+		assert(_alloc == other._alloc);
+
+	std::swap(_map, other._map);
+	std::swap(_map_size, other._map_size);
+	std::swap(_start_block, other._start_block);
+	std::swap(_start_offset, other._start_offset);
+	std::swap(_finish_block, other._finish_block);
+	std::swap(_finish_offset, other._finish_offset);
+	std::swap(_size, other._size);
+	std::swap(_spare, other._spare);
+	std::swap(_spare_count, other._spare_count);
+	std::swap(_spare_limit, other._spare_limit);
+	std::swap(_block_count, other._block_count);
+	std::swap(_shrink_after, other._shrink_after);
+	std::swap(_low_occupancy_drains, other._low_occupancy_drains);
+	std::swap(_keep_reserve, other._keep_reserve);
+	std::swap(_stats, other._stats);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::size_type Deque<_Ty>::size() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::insert(iterator pos, const_reference value)
 {
-	return _size;
+	return emplace(pos, value);
 }
 
-template<typename _Ty>
-inline bool Deque<_Ty>::empty() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::insert(iterator pos, value_type&& value)
 {
-	return _size == 0;
+	return emplace(pos, std::move(value));
 }
 
-template<typename _Ty>
-void Deque<_Ty>::resize(size_type new_size, const_reference value)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<std::input_iterator _InIt>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::insert(iterator pos, _InIt first, _InIt last)
 {
-	if (new_size < _size)
+	size_type index = pos - begin();
+	if (index == 0)
 	{
-		size_type to_destroy = _size - new_size;
-		size_type block = _finish_block;
-		size_type offset = _finish_offset;
-
-		while (to_destroy > 0)
-		{
-			if (offset == 0)
-			{
-				--block;
-				offset = BLOCK_SIZE;
-			}
-			--offset;
-			std::destroy_at(&_map[block][offset]);
-			--to_destroy;
-		}
+		prepend(first, last);
+		return begin();
+	}
 
-		_finish_block = block;
-		_finish_offset = offset;
-		_size = new_size;
+	size_type old_size = _size;
+	if (index < old_size / 2)
+	{
+		prepend(first, last);
+		size_type count = _size - old_size;
+		std::rotate(begin(), begin() + count, begin() + count + index);
 	}
-	else if (new_size > _size)
+	else
 	{
-		while (_size < new_size)
-			push_back(value);
+		append(first, last);
+		if (index != old_size)
+			std::rotate(begin() + index, begin() + old_size, end());
 	}
+	return begin() + index;
 }
 
-template<typename _Ty>
-inline void Deque<_Ty>::swap(Deque& other)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<std::input_iterator _InIt>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::append(_InIt first, _InIt last)
 {
-	std::swap(_map, other._map);
-	std::swap(_map_size, other._map_size);
-	std::swap(_start_block, other._start_block);
-	std::swap(_start_offset, other._start_offset);
-	std::swap(_finish_block, other._finish_block);
-	std::swap(_finish_offset, other._finish_offset);
-	std::swap(_size, other._size);
+	if constexpr (std::forward_iterator<_InIt>)
+		append_n(first, static_cast<size_type>(std::distance(first, last)));
+	else
+	{
+		for (; first != last; ++first)
+			emplace_back(*first);
+	}
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::iterator Deque<_Ty>::insert(iterator pos, const_reference value)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<std::input_iterator _InIt>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::prepend(_InIt first, _InIt last)
 {
-	size_type index = pos - begin();
-	if (index == size()) 
+	if constexpr (std::forward_iterator<_InIt>)
+		prepend_n(first, static_cast<size_type>(std::distance(first, last)));
+	else
 	{
-		push_back(value);
-		return end() - 1;
+		//  :  ,    
+		Deque buffer(get_allocator());
+		buffer.append(first, last);
+		prepend_n(std::make_move_iterator(buffer.begin()), buffer._size);
 	}
+}
 
-	push_back(back());
-	for (size_type i = size() - 1; i > index; --i)
-		(*this)[i] = (*this)[i - 1];
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<std::ranges::input_range _Range>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::append_range(_Range&& range)
+{
+	if constexpr (std::ranges::forward_range<_Range> || std::ranges::sized_range<_Range>)
+		append_n(std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+	else
+	{
+		for (auto&& elem : range)
+			emplace_back(std::forward<decltype(elem)>(elem));
+	}
+}
 
-	(*this)[index] = value;
-	return begin() + index;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<std::ranges::input_range _Range>
+void Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::prepend_range(_Range&& range)
+{
+	if constexpr (std::ranges::forward_range<_Range> || std::ranges::sized_range<_Range>)
+		prepend_n(std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+	else
+	{
+		Deque buffer(get_allocator());
+		buffer.append_range(std::forward<_Range>(range));
+		prepend_n(std::make_move_iterator(buffer.begin()), buffer._size);
+	}
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::iterator Deque<_Ty>::erase(iterator pos)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::erase(iterator pos)
 {
 	size_type index = pos - begin();
-	for (size_type i = index; i < size() - 1; ++i)
-		(*this)[i] = (*this)[i + 1];
+	if (index < _size / 2)
+	{
+		move_elements_backward(0, index, index + 1);
+		unchecked_pop_front();
+	}
+	else
+	{
+		move_elements(index + 1, _size, index);
+		unchecked_pop_back();
+	}
+	return begin() + index;
+}
 
-	pop_back();
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::erase(iterator first, iterator last)
+{
+	size_type index = first - begin();
+	size_type count = last - first;
+	if (count == 0)
+		return first;
+
+	if (index < (_size - count) / 2)
+	{
+		move_elements_backward(0, index, index + count);
+		erase_front(count);
+	}
+	else
+	{
+		size_type last_block = _finish_block;
+		move_elements(index + count, _size, index);
+		erase_back(count);
+		release_back_blocks(last_block);
+	}
+	note_block_drained();
 	return begin() + index;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::iterator Deque<_Ty>::begin()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::begin()
 {
 	return iterator(_map, _start_block, _start_offset);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::iterator Deque<_Ty>::end()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::end()
 {
 	return iterator(_map, _finish_block, _finish_offset);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_iterator Deque<_Ty>::begin() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::begin() const
 {
 	return const_iterator(_map, _start_block, _start_offset);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_iterator Deque<_Ty>::end() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::end() const
 {
 	return const_iterator(_map, _finish_block, _finish_offset);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_iterator Deque<_Ty>::cbegin() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::cbegin() const
 {
 	return begin();
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_iterator Deque<_Ty>::cend() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::cend() const
 {
 	return end();
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reverse_iterator Deque<_Ty>::rbegin()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::rbegin()
 {
 	return reverse_iterator(end());
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::reverse_iterator Deque<_Ty>::rend()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::rend()
 {
 	return reverse_iterator(begin());
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reverse_iterator Deque<_Ty>::rbegin() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::rbegin() const
 {
 	return const_reverse_iterator(end());
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reverse_iterator Deque<_Ty>::rend() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::rend() const
 {
 	return const_reverse_iterator(begin());
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reverse_iterator Deque<_Ty>::crbegin() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::crbegin() const
 {
 	return rbegin();
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::const_reverse_iterator Deque<_Ty>::crend() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reverse_iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::crend() const
 {
 	return rend();
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::operator==(const Deque& other) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::template Segment_View<_Ty> Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::segments()
 {
-	if (_size != other._size)
-		return false;
-	return std::equal(begin(), end(), other.begin());
+	return Segment_View<_Ty>(_map, _start_block, _start_offset, _finish_block, _finish_offset);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::template Segment_View<const _Ty> Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::segments() const
+{
+	return Segment_View<const _Ty>(_map, _start_block, _start_offset, _finish_block, _finish_offset);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::template Index_Cursor<_Ty> Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::cursor() noexcept
+{
+	return Index_Cursor<_Ty>(_map, _start_block, _start_offset);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::template Index_Cursor<const _Ty> Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::cursor() const noexcept
+{
+	return Index_Cursor<const _Ty>(_map, _start_block, _start_offset);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator==(const Deque& other) const
+{
+	return segmented_equal(*this, other);
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::operator!=(const Deque& other) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::operator!=(const Deque& other) const
 {
 	return !(*this == other);
 }
 
-template<typename _Ty>
-Deque<_Ty>::Iterator::Iterator() noexcept = default;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::Iterator() noexcept = default;
 
-template<typename _Ty>
-Deque<_Ty>::Iterator::Iterator(Map map, size_type block, size_type offset)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::Iterator(Map map, size_type block, size_type offset)
 	: _map_ptr(map)
 	, _block(block)
 	, _offset(offset)
 {
 }
 
-template<typename _Ty>
-Deque<_Ty>::Iterator::~Iterator() = default;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::~Iterator() = default;
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator::reference Deque<_Ty>::Iterator::operator*() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator*() const
 {
 	return _map_ptr[_block][_offset];
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator::pointer Deque<_Ty>::Iterator::operator->() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::pointer Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator->() const
 {
-	return &((*_map_ptr)[_block][_offset]);
+	return _map_ptr[_block] + _offset;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator++()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator++()
 {
 	if (++_offset == BLOCK_SIZE)
 	{
@@ -883,16 +2442,16 @@ typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator++()
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator++(int)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator++(int)
 {
 	Iterator temp = *this;
 	++(*this);
 	return temp;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator--()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator--()
 {
 	if (_offset == 0)
 	{
@@ -904,135 +2463,130 @@ typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator--()
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator--(int)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator--(int)
 {
 	Iterator temp = *this;
 	--(*this);
 	return temp;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator Deque<_Ty>::Iterator::operator+(difference_type n) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator+(difference_type n) const
 {
+	//     ,    n  
 	difference_type offset = static_cast<difference_type>(_offset) + n;
-	size_type block = _block + offset / BLOCK_SIZE;
-	size_type off = offset % BLOCK_SIZE;
-
-	if (off < 0) //   
-	{ 
-		block--;
-		off += BLOCK_SIZE;
-	}
+	size_type block = _block + static_cast<size_type>(offset >> BLOCK_SHIFT);
+	size_type off = static_cast<size_type>(offset) & BLOCK_MASK;
 	return Iterator(_map_ptr, block, off);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator Deque<_Ty>::Iterator::operator-(difference_type n) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator-(difference_type n) const
 {
 	return *this + (-n);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator+=(difference_type n)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator+=(difference_type n)
 {
 	*this = *this + n;
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator& Deque<_Ty>::Iterator::operator-=(difference_type n)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator-=(difference_type n)
 {
 	*this = *this - n;
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Iterator::reference Deque<_Ty>::Iterator::operator[](difference_type n) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator[](difference_type n) const
 {
 	return *(*this + n);
 }
 
-template <typename _Ty>  
-typename Deque<_Ty>::Iterator::difference_type Deque<_Ty>::Iterator::operator-(const Iterator& rhs) const  
+template <typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>  
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::difference_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator-(const Iterator& rhs) const  
 {  
 	difference_type block_diff = static_cast<difference_type>(_block) - rhs._block;
 	difference_type offset_diff = static_cast<difference_type>(_offset) - rhs._offset;
-	return block_diff * BLOCK_SIZE + offset_diff;
+	return block_diff * static_cast<difference_type>(BLOCK_SIZE) + offset_diff;
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::Iterator::operator==(const Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator==(const Iterator& rhs) const
 {
 	return _map_ptr == rhs._map_ptr && _block == rhs._block && _offset == rhs._offset;
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::Iterator::operator!=(const Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator!=(const Iterator& rhs) const
 {
 	return !(*this == rhs);
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::Iterator::operator<(const Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator<(const Iterator& rhs) const
 {
 	return (_map_ptr == rhs._map_ptr) && ((_block < rhs._block) || (_block == rhs._block && _offset < rhs._offset));
 }
 
-template<typename _Ty>
-bool Deque<_Ty>::Iterator::operator>(const Iterator& other) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator>(const Iterator& other) const
 {
 	return other < *this;
 }
 
-template <typename _Ty>
-bool Deque<_Ty>::Iterator::operator<=(const Iterator& other) const 
+template <typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator<=(const Iterator& other) const 
 {
 	return !(other < *this);
 }
 
-template <typename _Ty>
-bool Deque<_Ty>::Iterator::operator>=(const Iterator& other) const 
+template <typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Iterator::operator>=(const Iterator& other) const 
 {
 	return !(*this < other);
 }
 
-template<typename _Ty>
-Deque<_Ty>::Const_Iterator::Const_Iterator() noexcept = default;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::Const_Iterator() noexcept = default;
 
-template<typename _Ty>
-Deque<_Ty>::Const_Iterator::Const_Iterator(Map map, size_type block, size_type offset)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::Const_Iterator(Map map, size_type block, size_type offset)
 	: _map_ptr(map)
 	, _block(block)
 	, _offset(offset)
 {
 }
 
-template<typename _Ty>
-Deque<_Ty>::Const_Iterator::Const_Iterator(const Iterator& it)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::Const_Iterator(const Iterator& it)
 	: _map_ptr(it._map_ptr)
 	, _block(it._block)
 	, _offset(it._offset)
 {
 }
 
-template<typename _Ty>
-inline Deque<_Ty>::Const_Iterator::~Const_Iterator() = default;
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::~Const_Iterator() = default;
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator::reference Deque<_Ty>::Const_Iterator::operator*() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator*() const
 {
-	return (*_map_ptr)[_block][_offset];
+	return _map_ptr[_block][_offset];
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator::pointer Deque<_Ty>::Const_Iterator::operator->() const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::pointer Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator->() const
 {
-	return &((*_map_ptr)[_block][_offset]);
+	return _map_ptr[_block] + _offset;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator++()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator++()
 {
 	if (++_offset >= BLOCK_SIZE)
 	{
@@ -1042,16 +2596,16 @@ typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator++()
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator Deque<_Ty>::Const_Iterator::operator++(int)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator++(int)
 {
 	Const_Iterator temp = *this;
 	++(*this);
 	return temp;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator--()
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator--()
 {
 	if (_offset == 0)
 	{
@@ -1063,97 +2617,345 @@ typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator--()
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator Deque<_Ty>::Const_Iterator::operator--(int)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator--(int)
 {
 	Const_Iterator temp = *this;
 	--(*this);
 	return temp;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator Deque<_Ty>::Const_Iterator::operator+(difference_type n) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator+(difference_type n) const
 {
 	difference_type offset = static_cast<difference_type>(_offset) + n;
-	size_type block = _block + offset / BLOCK_SIZE;
-	size_type off = offset % BLOCK_SIZE;
-
-	if (off < 0) 
-	{ //   
-		block--;
-		off += BLOCK_SIZE;
-	}
+	size_type block = _block + static_cast<size_type>(offset >> BLOCK_SHIFT);
+	size_type off = static_cast<size_type>(offset) & BLOCK_MASK;
 	return Const_Iterator(_map_ptr, block, off);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator Deque<_Ty>::Const_Iterator::operator-(difference_type n) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator-(difference_type n) const
 {
 	return *this + (-n);
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator+=(difference_type n)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator+=(difference_type n)
 {
 	*this = *this + n;
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator& Deque<_Ty>::Const_Iterator::operator-=(difference_type n)
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator-=(difference_type n)
 {
 	*this = *this - n;
 	return *this;
 }
 
-template<typename _Ty>
-typename Deque<_Ty>::Const_Iterator::difference_type Deque<_Ty>::Const_Iterator::operator-(const Const_Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::difference_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator-(const Const_Iterator& rhs) const
 {
 	difference_type block_diff = static_cast<difference_type>(_block) - rhs._block;
 	difference_type offset_diff = static_cast<difference_type>(_offset) - rhs._offset;
-	return block_diff * BLOCK_SIZE + offset_diff;
+	return block_diff * static_cast<difference_type>(BLOCK_SIZE) + offset_diff;
 }
 
-template<typename _Ty>  
-typename Deque<_Ty>::const_reference Deque<_Ty>::Const_Iterator::operator[](difference_type n) const  
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>  
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_reference Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator[](difference_type n) const  
 {  
 	return *(*this + n);
 }
 
-template <typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator==(const Const_Iterator& rhs) const
+template <typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator==(const Const_Iterator& rhs) const
 {
 	return _map_ptr == rhs._map_ptr && _block == rhs._block && _offset == rhs._offset;
 }
 
-template <typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator!=(const Const_Iterator& rhs) const
+template <typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator!=(const Const_Iterator& rhs) const
 {
 	return !(*this == rhs);
 }
 
-template<typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator<(const Const_Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator<(const Const_Iterator& rhs) const
 {
 	return (_map_ptr == rhs._map_ptr) && ((_block < rhs._block) || (_block == rhs._block && _offset < rhs._offset));
 }
 
-template<typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator>(const Const_Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator>(const Const_Iterator& rhs) const
 {
 	return rhs < *this;
 }
 
-template<typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator<=(const Const_Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator<=(const Const_Iterator& rhs) const
 {
 	return !(*this > rhs);
 }
 
-template<typename _Ty>
-inline bool Deque<_Ty>::Const_Iterator::operator>=(const Const_Iterator& rhs) const
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Const_Iterator::operator>=(const Const_Iterator& rhs) const
 {
 	return !(*this < rhs);
 }
 
+// SEGMENT VIEW
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Index_Cursor<_Elem>::Index_Cursor(Map map, size_type start_block, size_type start_offset) noexcept
+	: _map_ptr(map)
+	, _start_block(start_block)
+	, _start_offset(start_offset)
+	, _block_first(size_type(0) - BLOCK_SIZE) //     
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline _Elem& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Index_Cursor<_Elem>::operator[](size_type index)
+{
+	size_type delta = index - _block_first;
+	if (delta < BLOCK_SIZE)
+		return _block_ptr[delta];
+	return seek(index);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+_Elem& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Index_Cursor<_Elem>::seek(size_type index)
+{
+	size_type offset = _start_offset + index;
+	_block_ptr = _map_ptr[_start_block + (offset >> BLOCK_SHIFT)];
+	_block_first = index - (offset & BLOCK_MASK);
+	return _block_ptr[offset & BLOCK_MASK];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_View(Map map, size_type start_block, size_type start_offset,
+	size_type finish_block, size_type finish_offset)
+	: _map_ptr(map)
+	, _start_block(start_block)
+	, _start_offset(start_offset)
+	, _finish_block(finish_block)
+	, _finish_offset(finish_offset)
+	, _end_block(start_block == finish_block && start_offset == finish_offset
+		? start_block
+		: finish_block + (finish_offset != 0 ? 1 : 0))
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::begin() const
+{
+	return Segment_Iterator(*this, _start_block);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::end() const
+{
+	return Segment_Iterator(*this, _end_block);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::size() const
+{
+	return _end_block - _start_block;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::empty() const
+{
+	return _end_block == _start_block;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::Segment_Iterator(const Segment_View& view, size_type block)
+	: _map_ptr(view._map_ptr)
+	, _block(block)
+	, _start_block(view._start_block)
+	, _start_offset(view._start_offset)
+	, _finish_block(view._finish_block)
+	, _finish_offset(view._finish_offset)
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline std::span<_Elem> Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::operator*() const
+{
+	size_type first = _block == _start_block ? _start_offset : 0;
+	size_type last = _block == _finish_block ? _finish_offset : BLOCK_SIZE;
+	return std::span<_Elem>(_map_ptr[_block] + first, last - first);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator& Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::operator++()
+{
+	++_block;
+	return *this;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::operator++(int)
+{
+	Segment_Iterator temp = *this;
+	++_block;
+	return temp;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::operator==(const Segment_Iterator& rhs) const
+{
+	return _map_ptr == rhs._map_ptr && _block == rhs._block;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+template<typename _Elem>
+inline bool Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::Segment_View<_Elem>::Segment_Iterator::operator!=(const Segment_Iterator& rhs) const
+{
+	return !(*this == rhs);
+}
+
+// SEGMENTED ALGORITHMS
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _Fn>
+_Fn segmented_for_each(Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, _Fn func)
+{
+	for (std::span<_Ty> segment : deque.segments())
+	{
+		for (_Ty& elem : segment)
+			func(elem);
+	}
+	return func;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _Fn>
+_Fn segmented_for_each(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, _Fn func)
+{
+	for (std::span<const _Ty> segment : deque.segments())
+	{
+		for (const _Ty& elem : segment)
+			func(elem);
+	}
+	return func;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _OutIt>
+_OutIt segmented_copy(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, _OutIt dest)
+{
+	for (std::span<const _Ty> segment : deque.segments())
+		dest = std::copy(segment.begin(), segment.end(), dest);
+	return dest;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats>
+void segmented_fill(Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, const _Ty& value)
+{
+	for (std::span<_Ty> segment : deque.segments())
+		std::fill(segment.begin(), segment.end(), value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _U>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type segmented_count(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, const _U& value)
+{
+	typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type result = 0;
+	for (std::span<const _Ty> segment : deque.segments())
+		result += static_cast<std::size_t>(std::count(segment.begin(), segment.end(), value));
+	return result;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _U>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::const_iterator segmented_find(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, const _U& value)
+{
+	std::size_t index = 0;
+	for (std::span<const _Ty> segment : deque.segments())
+	{
+		auto it = std::find(segment.begin(), segment.end(), value);
+		if (it != segment.end())
+			return deque.begin() + static_cast<std::ptrdiff_t>(index + (it - segment.begin()));
+		index += segment.size();
+	}
+	return deque.end();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _U>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::iterator segmented_find(Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, const _U& value)
+{
+	const auto& cdeque = deque;
+	return deque.begin() + (segmented_find(cdeque, value) - cdeque.begin());
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _Val, typename _Op = std::plus<>>
+_Val segmented_accumulate(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, _Val init, _Op op = _Op())
+{
+	for (std::span<const _Ty> segment : deque.segments())
+		init = std::accumulate(segment.begin(), segment.end(), std::move(init), op);
+	return init;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _Alloc2, typename _BlockPolicy2, std::size_t _InlineN2, typename _Stats2>
+bool segmented_equal(const Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& lhs, const Deque<_Ty, _Alloc2, _BlockPolicy2, _InlineN2, _Stats2>& rhs)
+{
+	if (lhs.size() != rhs.size())
+		return false;
+
+	//       ,   
+	auto lhs_segments = lhs.segments();
+	auto rhs_segments = rhs.segments();
+	auto lhs_it = lhs_segments.begin();
+	auto rhs_it = rhs_segments.begin();
+	std::span<const _Ty> lhs_chunk;
+	std::span<const _Ty> rhs_chunk;
+
+	while (true)
+	{
+		if (lhs_chunk.empty())
+		{
+			if (lhs_it == lhs_segments.end())
+				return true;
+			lhs_chunk = *lhs_it++;
+		}
+		if (rhs_chunk.empty())
+			rhs_chunk = *rhs_it++;
+
+		std::size_t n = std::min(lhs_chunk.size(), rhs_chunk.size());
+		if (!std::equal(lhs_chunk.begin(), lhs_chunk.begin() + n, rhs_chunk.begin()))
+			return false;
+
+		lhs_chunk = lhs_chunk.subspan(n);
+		rhs_chunk = rhs_chunk.subspan(n);
+	}
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _Pred>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type erase_if(Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, _Pred pred)
+{
+	//    ,    
+	auto it = std::remove_if(deque.begin(), deque.end(), pred);
+	auto count = static_cast<typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type>(deque.end() - it);
+	deque.erase(it, deque.end());
+	return count;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy, std::size_t _InlineN, typename _Stats, typename _U>
+typename Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>::size_type erase(Deque<_Ty, _Alloc, _BlockPolicy, _InlineN, _Stats>& deque, const _U& value)
+{
+	return erase_if(deque, [&value](const _Ty& elem) { return elem == value; });
+}
+
 
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.h"
+
+//    /      ,   Deque.
+//    ,    ;  
+//  ,     ,     .
+
+template <typename _Ty, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Bytes<4096>>
+class SpscDeque
+{
+private:
+	static constexpr std::size_t BLOCK_SIZE = _BlockPolicy::template size<_Ty>;
+	static constexpr std::size_t BLOCK_MASK = BLOCK_SIZE - 1;
+	static constexpr std::size_t CACHE_LINE = 64;
+
+	static_assert(std::has_single_bit(BLOCK_SIZE), "block size must be a power of two");
+
+	struct Node
+	{
+		Node* next;
+		alignas(_Ty) unsigned char storage[sizeof(_Ty) * BLOCK_SIZE];
+	};
+
+	using _Alty = typename std::allocator_traits<_Alloc>::template rebind_alloc<_Ty>;
+	using _Alty_traits = std::allocator_traits<_Alty>;
+	using _Node_alloc = typename _Alty_traits::template rebind_alloc<Node>;
+	using _Node_traits = std::allocator_traits<_Node_alloc>;
+
+	[[no_unique_address]] _Alty _alloc;
+
+	//  
+	alignas(CACHE_LINE) std::atomic<std::size_t> _head{ 0 };
+	Node* _head_block = nullptr;
+	std::size_t _tail_cache = 0;
+
+	//  
+	alignas(CACHE_LINE) std::atomic<std::size_t> _tail{ 0 };
+	Node* _tail_block = nullptr;
+	std::size_t _head_cache = 0;
+	Node* _oldest = nullptr;        //  ;   _head_block  
+	std::size_t _oldest_start = 0;  //    _oldest
+
+	Node* create_node();
+	void delete_node(Node* node);
+	Node* acquire_node();
+
+	static _Ty* slot(Node* node, std::size_t index);
+
+public:
+	using value_type = _Ty;
+	using allocator_type = _Alloc;
+	using size_type = std::size_t;
+	using reference = _Ty&;
+	using const_reference = const _Ty&;
+
+	SpscDeque();
+	explicit SpscDeque(const allocator_type& alloc);
+	SpscDeque(const SpscDeque&) = delete;
+	SpscDeque& operator=(const SpscDeque&) = delete;
+	~SpscDeque();
+
+	allocator_type get_allocator() const noexcept;
+
+	// PRODUCER
+
+	void push_back(const_reference value);
+	void push_back(value_type&& value);
+	template<typename ...Args>
+	void emplace_back(Args&&... args);
+
+	// CONSUMER
+
+	bool try_pop_front(reference out);
+	template<typename _Fn>
+	bool consume_front(_Fn&& func);
+
+	// ,     
+	size_type size() const noexcept;
+	bool empty() const noexcept;
+
+	static constexpr size_type block_size() noexcept;
+};
+
+// IMPLEMENTATION
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename SpscDeque<_Ty, _Alloc, _BlockPolicy>::Node* SpscDeque<_Ty, _Alloc, _BlockPolicy>::create_node()
+{
+	_Node_alloc node_alloc(_alloc);
+	Node* node = _Node_traits::allocate(node_alloc, 1);
+	node->next = nullptr;
+	return node;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void SpscDeque<_Ty, _Alloc, _BlockPolicy>::delete_node(Node* node)
+{
+	_Node_alloc node_alloc(_alloc);
+	_Node_traits::deallocate(node_alloc, node, 1);
+}
+
+//   :    ,      
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename SpscDeque<_Ty, _Alloc, _BlockPolicy>::Node* SpscDeque<_Ty, _Alloc, _BlockPolicy>::acquire_node()
+{
+	if (_oldest != _tail_block)
+	{
+		//      ,    
+		if (_head_cache <= _oldest_start + BLOCK_SIZE)
+			_head_cache = _head.load(std::memory_order_acquire);
+
+		if (_head_cache > _oldest_start + BLOCK_SIZE)
+		{
+			Node* node = _oldest;
+			_oldest = node->next;
+			_oldest_start += BLOCK_SIZE;
+			node->next = nullptr;
+			return node;
+		}
+	}
+	return create_node();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline _Ty* SpscDeque<_Ty, _Alloc, _BlockPolicy>::slot(Node* node, std::size_t index)
+{
+	return reinterpret_cast<_Ty*>(node->storage) + (index & BLOCK_MASK);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline SpscDeque<_Ty, _Alloc, _BlockPolicy>::SpscDeque()
+	: SpscDeque(allocator_type())
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+SpscDeque<_Ty, _Alloc, _BlockPolicy>::SpscDeque(const allocator_type& alloc)
+	: _alloc(alloc)
+{
+	//    :      
+	_oldest = _tail_block = _head_block = create_node();
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+SpscDeque<_Ty, _Alloc, _BlockPolicy>::~SpscDeque()
+{
+	std::size_t head = _head.load(std::memory_order_relaxed);
+	std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+	//   ,    
+	Node* block = _head_block;
+	for (; head != tail; ++head)
+	{
+		if ((head & BLOCK_MASK) == 0 && head != 0)
+			block = block->next;
+		_Alty_traits::destroy(_alloc, slot(block, head));
+	}
+
+	while (_oldest)
+		delete_node(std::exchange(_oldest, _oldest->next));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename SpscDeque<_Ty, _Alloc, _BlockPolicy>::allocator_type SpscDeque<_Ty, _Alloc, _BlockPolicy>::get_allocator() const noexcept
+{
+	return allocator_type(_alloc);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline void SpscDeque<_Ty, _Alloc, _BlockPolicy>::push_back(const_reference value)
+{
+	emplace_back(value);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline void SpscDeque<_Ty, _Alloc, _BlockPolicy>::push_back(value_type&& value)
+{
+	emplace_back(std::move(value));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename ...Args>
+void SpscDeque<_Ty, _Alloc, _BlockPolicy>::emplace_back(Args&&... args)
+{
+	std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+	if ((tail & BLOCK_MASK) == 0 && tail != 0)
+	{
+		//           release .
+		//   ,      
+		//   ,  _tail_block    
+		Node* node = _tail_block->next;
+		if (node == nullptr)
+		{
+			node = acquire_node();
+			_tail_block->next = node;
+		}
+
+		_Alty_traits::construct(_alloc, slot(node, tail), std::forward<Args>(args)...);
+		_tail_block = node;
+	}
+	else
+		_Alty_traits::construct(_alloc, slot(_tail_block, tail), std::forward<Args>(args)...);
+
+	_tail.store(tail + 1, std::memory_order_release);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool SpscDeque<_Ty, _Alloc, _BlockPolicy>::try_pop_front(reference out)
+{
+	return consume_front([&out](_Ty& elem) { out = std::move(elem); });
+}
+
+// func       
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+template<typename _Fn>
+bool SpscDeque<_Ty, _Alloc, _BlockPolicy>::consume_front(_Fn&& func)
+{
+	std::size_t head = _head.load(std::memory_order_relaxed);
+
+	if (head == _tail_cache)
+	{
+		_tail_cache = _tail.load(std::memory_order_acquire);
+		if (head == _tail_cache)
+			return false;
+	}
+
+	if ((head & BLOCK_MASK) == 0 && head != 0)
+		_head_block = _head_block->next;
+
+	_Ty* elem = slot(_head_block, head);
+	func(*elem);
+	_Alty_traits::destroy(_alloc, elem);
+
+	//  release    
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline typename SpscDeque<_Ty, _Alloc, _BlockPolicy>::size_type SpscDeque<_Ty, _Alloc, _BlockPolicy>::size() const noexcept
+{
+	std::size_t head = _head.load(std::memory_order_acquire);
+	std::size_t tail = _tail.load(std::memory_order_acquire);
+	return tail >= head ? tail - head : 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool SpscDeque<_Ty, _Alloc, _BlockPolicy>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+constexpr typename SpscDeque<_Ty, _Alloc, _BlockPolicy>::size_type SpscDeque<_Ty, _Alloc, _BlockPolicy>::block_size() noexcept
+{
+	return BLOCK_SIZE;
+}
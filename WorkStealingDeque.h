@@ -0,0 +1,298 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.h"
+
+//  -  :      ,
+//    .   ;    
+// ,       .  
+//   ,      .
+
+template <typename _Ty, typename _Alloc = std::allocator<_Ty>, typename _BlockPolicy = Deque_Block_Bytes<4096>>
+class WorkStealingDeque
+{
+private:
+	static_assert(std::is_trivially_copyable_v<_Ty>,
+		"WorkStealingDeque reads elements speculatively and needs a trivially copyable type");
+
+	using Slot = std::atomic<_Ty>;
+	using Block = Slot*;
+
+	static constexpr std::size_t BLOCK_SIZE = _BlockPolicy::template size<Slot>;
+	static constexpr std::size_t BLOCK_SHIFT = std::countr_zero(BLOCK_SIZE);
+	static constexpr std::size_t BLOCK_MASK = BLOCK_SIZE - 1;
+	static constexpr std::size_t INITIAL_BLOCKS = 4;
+	static constexpr std::size_t CACHE_LINE = 64;
+
+	static_assert(std::has_single_bit(BLOCK_SIZE), "block size must be a power of two");
+
+	struct Map
+	{
+		std::size_t block_count;  //  
+		Block* blocks;
+		Map* retired;             //  
+	};
+
+	using _Slot_alloc = typename std::allocator_traits<_Alloc>::template rebind_alloc<Slot>;
+	using _Slot_traits = std::allocator_traits<_Slot_alloc>;
+	using _Block_alloc = typename std::allocator_traits<_Alloc>::template rebind_alloc<Block>;
+	using _Block_traits = std::allocator_traits<_Block_alloc>;
+	using _Map_alloc = typename std::allocator_traits<_Alloc>::template rebind_alloc<Map>;
+	using _Map_traits = std::allocator_traits<_Map_alloc>;
+
+	[[no_unique_address]] _Slot_alloc _alloc;
+
+	alignas(CACHE_LINE) std::atomic<std::int64_t> _top{ 0 };
+	alignas(CACHE_LINE) std::atomic<std::int64_t> _bottom{ 0 };
+	std::atomic<Map*> _map{ nullptr };
+
+	Block allocate_block();
+	void deallocate_block(Block block);
+	Map* create_map(std::size_t block_count, Map* retired);
+	void delete_map(Map* map);
+	Map* grow_map(Map* map, std::int64_t top, std::int64_t bottom);
+
+	static Slot& slot(const Map* map, std::int64_t index);
+
+public:
+	using value_type = _Ty;
+	using allocator_type = _Alloc;
+	using size_type = std::size_t;
+
+	WorkStealingDeque();
+	explicit WorkStealingDeque(const allocator_type& alloc);
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+	~WorkStealingDeque();
+
+	allocator_type get_allocator() const noexcept;
+
+	// OWNER
+
+	void push_back(const _Ty& value);
+	bool try_pop_back(_Ty& out);
+
+	// THIEVES
+
+	// false:       
+	bool try_steal_front(_Ty& out);
+
+	//    
+	size_type size() const noexcept;
+	bool empty() const noexcept;
+
+	static constexpr size_type block_size() noexcept;
+};
+
+// IMPLEMENTATION
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::Block WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::allocate_block()
+{
+	Block block = _Slot_traits::allocate(_alloc, BLOCK_SIZE);
+	std::uninitialized_default_construct_n(block, BLOCK_SIZE);
+	return block;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::deallocate_block(Block block)
+{
+	std::destroy_n(block, BLOCK_SIZE);
+	_Slot_traits::deallocate(_alloc, block, BLOCK_SIZE);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::Map* WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::create_map(std::size_t block_count, Map* retired)
+{
+	_Map_alloc map_alloc(_alloc);
+	_Block_alloc block_alloc(_alloc);
+
+	Map* map = _Map_traits::allocate(map_alloc, 1);
+	map->block_count = block_count;
+	map->blocks = _Block_traits::allocate(block_alloc, block_count);
+	map->retired = retired;
+	for (std::size_t i = 0; i < block_count; ++i)
+		map->blocks[i] = nullptr;
+	return map;
+}
+
+//     ,    
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::delete_map(Map* map)
+{
+	_Map_alloc map_alloc(_alloc);
+	_Block_alloc block_alloc(_alloc);
+
+	_Block_traits::deallocate(block_alloc, map->blocks, map->block_count);
+	_Map_traits::deallocate(map_alloc, map, 1);
+}
+
+//  ,       block_count
+//  :         
+// ,          .
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::Map* WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::grow_map(Map* map, std::int64_t top, std::int64_t bottom)
+{
+	std::size_t old_count = map->block_count;
+	std::size_t new_count = old_count * 2;
+	Map* new_map = create_map(new_count, map);
+
+	std::int64_t first_block = top >> BLOCK_SHIFT;
+	std::int64_t last_block = (bottom + static_cast<std::int64_t>(BLOCK_MASK)) >> BLOCK_SHIFT;
+
+	//         
+	for (std::int64_t b = first_block; b < last_block; ++b)
+	{
+		std::size_t from = static_cast<std::size_t>(b) & (old_count - 1);
+		new_map->blocks[static_cast<std::size_t>(b) & (new_count - 1)] = map->blocks[from];
+	}
+
+	//     ,    ;
+	//      ,  
+	std::size_t live_count = static_cast<std::size_t>(last_block - first_block);
+	std::size_t next_slot = 0;
+	for (std::size_t i = 0; i < old_count - live_count; ++i)
+	{
+		while (new_map->blocks[next_slot] != nullptr)
+			++next_slot;
+		new_map->blocks[next_slot] = map->blocks[(static_cast<std::size_t>(last_block) + i) & (old_count - 1)];
+	}
+
+	for (; next_slot < new_count; ++next_slot)
+	{
+		if (new_map->blocks[next_slot] == nullptr)
+			new_map->blocks[next_slot] = allocate_block();
+	}
+
+	return new_map;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::Slot& WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::slot(const Map* map, std::int64_t index)
+{
+	std::size_t position = static_cast<std::size_t>(index);
+	return map->blocks[(position >> BLOCK_SHIFT) & (map->block_count - 1)][position & BLOCK_MASK];
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::WorkStealingDeque()
+	: WorkStealingDeque(allocator_type())
+{
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::WorkStealingDeque(const allocator_type& alloc)
+	: _alloc(alloc)
+{
+	Map* map = create_map(INITIAL_BLOCKS, nullptr);
+	for (std::size_t i = 0; i < INITIAL_BLOCKS; ++i)
+		map->blocks[i] = allocate_block();
+	_map.store(map, std::memory_order_relaxed);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::~WorkStealingDeque()
+{
+	Map* map = _map.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < map->block_count; ++i)
+		deallocate_block(map->blocks[i]);
+
+	while (map)
+		delete_map(std::exchange(map, map->retired));
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::allocator_type WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::get_allocator() const noexcept
+{
+	return allocator_type(_alloc);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+void WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::push_back(const _Ty& value)
+{
+	std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+	std::int64_t top = _top.load(std::memory_order_acquire);
+	Map* map = _map.load(std::memory_order_relaxed);
+
+	//    ,     
+	std::int64_t limit = static_cast<std::int64_t>((map->block_count - 1) * BLOCK_SIZE);
+	if (bottom - top >= limit)
+	{
+		map = grow_map(map, top, bottom);
+		_map.store(map, std::memory_order_release);
+	}
+
+	slot(map, bottom).store(value, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::try_pop_back(_Ty& out)
+{
+	std::int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+	Map* map = _map.load(std::memory_order_relaxed);
+	_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t top = _top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	out = slot(map, bottom).load(std::memory_order_relaxed);
+	if (top < bottom)
+		return true;
+
+	//  :   
+	bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	_bottom.store(bottom + 1, std::memory_order_relaxed);
+	return won;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+bool WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::try_steal_front(_Ty& out)
+{
+	std::int64_t top = _top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+		return false;
+
+	Map* map = _map.load(std::memory_order_acquire);
+	_Ty value = slot(map, top).load(std::memory_order_relaxed);
+	if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return false;
+
+	out = value;
+	return true;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::size_type WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::size() const noexcept
+{
+	std::int64_t bottom = _bottom.load(std::memory_order_relaxed);
+	std::int64_t top = _top.load(std::memory_order_relaxed);
+	return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+inline bool WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::empty() const noexcept
+{
+	return size() == 0;
+}
+
+template<typename _Ty, typename _Alloc, typename _BlockPolicy>
+constexpr typename WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::size_type WorkStealingDeque<_Ty, _Alloc, _BlockPolicy>::block_size() noexcept
+{
+	return BLOCK_SIZE;
+}
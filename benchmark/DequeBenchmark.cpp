@@ -0,0 +1,463 @@
+// : g++ -std=c++20 -O2 -DNDEBUG benchmark/DequeBenchmark.cpp -o deque_bench
+// : deque_bench [--max-size N] [--budget-mb N] [--min-time SEC] [--filter TEXT]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Deque.h"
+
+// COUNTING ALLOCATION
+
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	++g_allocations;
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+// HELPERS
+
+template <typename _Ty>
+inline void do_not_optimize(const _Ty& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+template <std::size_t N>
+struct Payload
+{
+	unsigned char bytes[N];
+
+	Payload() = default;
+	explicit Payload(std::size_t value)
+	{
+		std::memset(bytes, static_cast<unsigned char>(value), N);
+	}
+};
+
+//    ,   
+template <typename _Ty>
+class Ring_Buffer
+{
+public:
+	Ring_Buffer() = default;
+	Ring_Buffer(const Ring_Buffer&) = default;
+	Ring_Buffer(Ring_Buffer&&) noexcept = default;
+
+	void push_back(const _Ty& value)
+	{
+		if (_size == _data.size())
+			grow();
+		_data[(_head + _size) & (_data.size() - 1)] = value;
+		++_size;
+	}
+
+	void push_front(const _Ty& value)
+	{
+		if (_size == _data.size())
+			grow();
+		_head = (_head - 1) & (_data.size() - 1);
+		_data[_head] = value;
+		++_size;
+	}
+
+	void pop_back() { --_size; }
+
+	void pop_front()
+	{
+		_head = (_head + 1) & (_data.size() - 1);
+		--_size;
+	}
+
+	_Ty& operator[](std::size_t index) { return _data[(_head + index) & (_data.size() - 1)]; }
+	std::size_t size() const { return _size; }
+	void clear() { _head = _size = 0; }
+
+	template <typename _Fn>
+	void for_each(_Fn func)
+	{
+		std::size_t first = std::min(_size, _data.size() - _head);
+		for (std::size_t i = 0; i < first; ++i)
+			func(_data[_head + i]);
+		for (std::size_t i = 0; i < _size - first; ++i)
+			func(_data[i]);
+	}
+
+private:
+	void grow()
+	{
+		std::vector<_Ty> data(_data.empty() ? 16 : _data.size() * 2);
+		for (std::size_t i = 0; i < _size; ++i)
+			data[i] = (*this)[i];
+		_data.swap(data);
+		_head = 0;
+	}
+
+	std::vector<_Ty> _data;
+	std::size_t _head = 0;
+	std::size_t _size = 0;
+};
+
+// BENCHMARK DRIVER
+
+struct Options
+{
+	std::size_t max_size = 10'000'000;
+	std::size_t budget_bytes = std::size_t(1) << 30;
+	double min_time = 0.05;
+	std::string filter;
+};
+
+struct Sample
+{
+	double ns = 0;
+	std::size_t ops = 0;
+	std::size_t allocations = 0;
+};
+
+class Stopwatch
+{
+public:
+	void start()
+	{
+		_allocations = g_allocations;
+		_start = std::chrono::steady_clock::now();
+	}
+
+	void stop(Sample& sample, std::size_t ops)
+	{
+		auto finish = std::chrono::steady_clock::now();
+		sample.ns += std::chrono::duration<double, std::nano>(finish - _start).count();
+		sample.allocations += g_allocations - _allocations;
+		sample.ops += ops;
+	}
+
+private:
+	std::chrono::steady_clock::time_point _start;
+	std::size_t _allocations = 0;
+};
+
+template <typename _Container>
+constexpr bool HAS_FRONT = requires(_Container& c) { c.push_front(c[0]); c.pop_front(); };
+
+template <typename _Container>
+constexpr bool HAS_INSERT = requires(_Container& c) { c.insert(c.begin(), c[0]); c.erase(c.begin()); };
+
+template <typename _Container>
+constexpr bool IS_DEQUE = requires(_Container& c) { c.segments(); };
+
+template <typename _Container>
+constexpr bool IS_RING = requires(_Container& c) { c.for_each([](auto&) {}); };
+
+template <typename _Ty>
+struct Value_Type
+{
+	using type = typename _Ty::value_type;
+};
+
+template <typename _Ty>
+struct Value_Type<Ring_Buffer<_Ty>>
+{
+	using type = _Ty;
+};
+
+template <typename _Container>
+void fill_back(_Container& c, std::size_t n)
+{
+	using _Ty = typename Value_Type<_Container>::type;
+	for (std::size_t i = 0; i < n; ++i)
+		c.push_back(_Ty(i));
+}
+
+class Runner
+{
+public:
+	explicit Runner(const Options& options)
+		: _options(options)
+	{
+	}
+
+	// body(stopwatch, sample)        
+	template <typename _Body>
+	void run(const char* name, const char* container, std::size_t elem_bytes, std::size_t n, _Body body)
+	{
+		std::string label = std::string(name) + "/" + container;
+		if (!_options.filter.empty() && label.find(_options.filter) == std::string::npos)
+			return;
+
+		Sample sample;
+		Stopwatch stopwatch;
+		do
+			body(stopwatch, sample);
+		while (sample.ns < _options.min_time * 1e9);
+
+		double ops = static_cast<double>(std::max<std::size_t>(sample.ops, 1));
+		std::printf("%-18s %-12s %5zu %11zu %12.2f %10.4f\n", name, container, elem_bytes, n,
+			sample.ns / ops, static_cast<double>(sample.allocations) / ops);
+	}
+
+private:
+	const Options& _options;
+};
+
+template <typename _Container>
+void run_container(Runner& runner, const char* container, std::size_t n)
+{
+	using _Ty = typename Value_Type<_Container>::type;
+	constexpr std::size_t BYTES = sizeof(_Ty);
+
+	runner.run("push_back", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		sw.start();
+		fill_back(c, n);
+		do_not_optimize(c);
+		sw.stop(sample, n);
+	});
+
+	if constexpr (HAS_FRONT<_Container>)
+	{
+		runner.run("push_front", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+			_Container c;
+			sw.start();
+			for (std::size_t i = 0; i < n; ++i)
+				c.push_front(_Ty(i));
+			do_not_optimize(c);
+			sw.stop(sample, n);
+		});
+
+		runner.run("pop_front", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+			_Container c;
+			fill_back(c, n);
+			sw.start();
+			for (std::size_t i = 0; i < n; ++i)
+				c.pop_front();
+			do_not_optimize(c);
+			sw.stop(sample, n);
+		});
+
+		runner.run("fifo_churn", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+			_Container c;
+			fill_back(c, n);
+			sw.start();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				c.push_back(_Ty(i));
+				c.pop_front();
+			}
+			do_not_optimize(c);
+			sw.stop(sample, n);
+		});
+	}
+
+	runner.run("pop_back", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		sw.start();
+		for (std::size_t i = 0; i < n; ++i)
+			c.pop_back();
+		do_not_optimize(c);
+		sw.stop(sample, n);
+	});
+
+	runner.run("random_index", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		std::size_t lookups = std::min<std::size_t>(n, 1 << 20);
+		std::size_t index = 0;
+		unsigned sum = 0;
+		sw.start();
+		for (std::size_t i = 0; i < lookups; ++i)
+		{
+			index = (index + 7919) % n;
+			sum += c[index].bytes[0];
+		}
+		do_not_optimize(sum);
+		sw.stop(sample, lookups);
+	});
+
+	runner.run("index_scan", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		unsigned sum = 0;
+		sw.start();
+		for (std::size_t i = 0; i < n; ++i)
+			sum += c[i].bytes[0];
+		do_not_optimize(sum);
+		sw.stop(sample, n);
+	});
+
+	if constexpr (IS_DEQUE<_Container>)
+	{
+		runner.run("index_scan_cursor", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+			_Container c;
+			fill_back(c, n);
+			unsigned sum = 0;
+			sw.start();
+			auto cursor = std::as_const(c).cursor();
+			for (std::size_t i = 0; i < n; ++i)
+				sum += cursor[i].bytes[0];
+			do_not_optimize(sum);
+			sw.stop(sample, n);
+		});
+	}
+
+	runner.run("iterate", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		unsigned sum = 0;
+		sw.start();
+		if constexpr (IS_RING<_Container>)
+			c.for_each([&sum](const _Ty& elem) { sum += elem.bytes[0]; });
+		else
+		{
+			for (const _Ty& elem : c)
+				sum += elem.bytes[0];
+		}
+		do_not_optimize(sum);
+		sw.stop(sample, n);
+	});
+
+	if constexpr (IS_DEQUE<_Container>)
+	{
+		runner.run("iterate_segment", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+			_Container c;
+			fill_back(c, n);
+			unsigned sum = 0;
+			sw.start();
+			segmented_for_each(c, [&sum](const _Ty& elem) { sum += elem.bytes[0]; });
+			do_not_optimize(sum);
+			sw.stop(sample, n);
+		});
+	}
+
+	//    ,   
+	if constexpr (HAS_INSERT<_Container>)
+	{
+		if (n <= 100'000)
+		{
+			runner.run("insert_middle", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+				_Container c;
+				fill_back(c, n);
+				std::size_t count = std::min<std::size_t>(n, 1000);
+				sw.start();
+				for (std::size_t i = 0; i < count; ++i)
+					c.insert(c.begin() + static_cast<std::ptrdiff_t>(c.size() / 2), _Ty(i));
+				do_not_optimize(c);
+				sw.stop(sample, count);
+			});
+
+			runner.run("erase_middle", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+				_Container c;
+				fill_back(c, n);
+				std::size_t count = std::min<std::size_t>(n, 1000);
+				sw.start();
+				for (std::size_t i = 0; i < count; ++i)
+					c.erase(c.begin() + static_cast<std::ptrdiff_t>(c.size() / 2));
+				do_not_optimize(c);
+				sw.stop(sample, count);
+			});
+		}
+	}
+
+	runner.run("copy", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		sw.start();
+		_Container copy(c);
+		do_not_optimize(copy);
+		sw.stop(sample, n);
+	});
+
+	runner.run("move", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		sw.start();
+		_Container moved(std::move(c));
+		do_not_optimize(moved);
+		sw.stop(sample, 1);
+	});
+
+	runner.run("clear", container, BYTES, n, [n](Stopwatch& sw, Sample& sample) {
+		_Container c;
+		fill_back(c, n);
+		sw.start();
+		c.clear();
+		do_not_optimize(c);
+		sw.stop(sample, n);
+	});
+}
+
+template <std::size_t N>
+void run_element_size(Runner& runner, const Options& options)
+{
+	using _Ty = Payload<N>;
+
+	for (std::size_t n = 10; n <= options.max_size; n *= 10)
+	{
+		//        
+		if (n * sizeof(_Ty) * 3 > options.budget_bytes)
+			break;
+
+		run_container<Deque<_Ty>>(runner, "Deque", n);
+		run_container<std::deque<_Ty>>(runner, "std::deque", n);
+		run_container<std::vector<_Ty>>(runner, "std::vector", n);
+		run_container<Ring_Buffer<_Ty>>(runner, "ring", n);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string arg = argv[i];
+		if (arg == "--max-size")
+			options.max_size = std::strtoull(argv[i + 1], nullptr, 10);
+		else if (arg == "--budget-mb")
+			options.budget_bytes = std::strtoull(argv[i + 1], nullptr, 10) << 20;
+		else if (arg == "--min-time")
+			options.min_time = std::strtod(argv[i + 1], nullptr);
+		else if (arg == "--filter")
+			options.filter = argv[i + 1];
+		else
+		{
+			std::fprintf(stderr, "unknown option: %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	std::printf("%-18s %-12s %5s %11s %12s %10s\n", "case", "container", "bytes", "size", "ns/op", "allocs/op");
+
+	Runner runner(options);
+	run_element_size<1>(runner, options);
+	run_element_size<8>(runner, options);
+	run_element_size<32>(runner, options);
+	run_element_size<256>(runner, options);
+}
@@ -0,0 +1,179 @@
+// : g++ -std=c++20 -O1 -g -pthread -fsanitize=thread tests/BlockingQueueTest.cpp -o blocking_test
+// : blocking_test;   -   
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../BlockingQueue.h"
+#include "Check.h"
+
+using namespace std::chrono_literals;
+
+// WAKEUPS
+
+//     ,    ,    
+//    
+static void test_bulk_wakes_enough_readers()
+{
+	BlockingQueue<int> queue;
+	constexpr int READERS = 4;
+	std::atomic<int> received{ 0 };
+
+	std::vector<std::thread> readers;
+	for (int i = 0; i < READERS; ++i)
+		readers.emplace_back([&]
+		{
+			int value = 0;
+			if (queue.pop_front_wait(value, 5s))
+				++received;
+		});
+
+	while (queue.waiters() != READERS)
+		std::this_thread::yield();
+
+	int batch[2] = { 1, 2 };
+	queue.push_back_bulk_notify(batch, 2);
+	queue.push_back_notify(3);
+	queue.push_back_notify(4);
+
+	for (auto& reader : readers)
+		reader.join();
+	CHECK(received == READERS);
+	CHECK(queue.empty() && queue.waiters() == 0);
+}
+
+static void test_timeout()
+{
+	BlockingQueue<int> queue;
+	int value = 0;
+	auto start = std::chrono::steady_clock::now();
+	CHECK(!queue.pop_front_wait(value, 20ms));
+	CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+	CHECK(queue.waiters() == 0);
+}
+
+// EXCEPTIONS
+
+//     
+struct Throwing_Assign
+{
+	int value = 0;
+
+	Throwing_Assign() = default;
+	Throwing_Assign(int v) : value(v) {}
+	Throwing_Assign(const Throwing_Assign&) = default;
+	Throwing_Assign(Throwing_Assign&&) = default;
+	Throwing_Assign& operator=(const Throwing_Assign&) = default;
+	Throwing_Assign& operator=(Throwing_Assign&& other)
+	{
+		if (other.value < 0)
+			throw std::runtime_error("poisoned move");
+		value = other.value;
+		return *this;
+	}
+};
+
+//         
+static void test_throw_while_waiting()
+{
+	BlockingQueue<Throwing_Assign> queue;
+	std::atomic<bool> thrown{ false };
+
+	std::thread reader([&]
+	{
+		Throwing_Assign out;
+		try
+		{
+			queue.pop_front_wait(out, 5s);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+	});
+
+	while (queue.waiters() != 1)
+		std::this_thread::yield();
+	queue.push_back_notify(Throwing_Assign(-1));
+	reader.join();
+
+	CHECK(thrown);
+	CHECK(queue.waiters() == 0);
+}
+
+// STRESS
+
+//       
+static void test_stress_exactly_once()
+{
+	constexpr int PRODUCERS = 3;
+	constexpr int CONSUMERS = 4;
+	constexpr long PER_PRODUCER = 20000;
+
+	BlockingQueue<long> queue;
+	std::vector<std::atomic<int>> seen(PRODUCERS * PER_PRODUCER);
+	std::atomic<long> received{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int c = 0; c < CONSUMERS; ++c)
+		threads.emplace_back([&, c]
+		{
+			long values[8];
+			while (received.load() < PRODUCERS * PER_PRODUCER)
+			{
+				std::size_t count = 0;
+				if (c % 2)
+					count = queue.pop_front_wait(values[0], 5ms) ? 1 : 0;
+				else
+					count = queue.pop_front_bulk_wait(values, 8, 5ms);
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					++seen[values[i]];
+					++received;
+				}
+			}
+		});
+
+	for (int p = 0; p < PRODUCERS; ++p)
+		threads.emplace_back([&, p]
+		{
+			for (long i = 0; i < PER_PRODUCER;)
+			{
+				if (i % 3 == 0)
+				{
+					long batch[4];
+					long count = std::min<long>(4, PER_PRODUCER - i);
+					for (long j = 0; j < count; ++j)
+						batch[j] = p * PER_PRODUCER + i + j;
+					queue.push_back_bulk_notify(batch, count);
+					i += count;
+				}
+				else
+					queue.push_back_notify(p * PER_PRODUCER + i++);
+			}
+		});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	bool exactly_once = true;
+	for (auto& count : seen)
+		exactly_once = exactly_once && count == 1;
+	CHECK(exactly_once);
+	CHECK(queue.empty());
+}
+
+int main()
+{
+	test_timeout();
+	test_bulk_wakes_enough_readers();
+	test_throw_while_waiting();
+	test_stress_exactly_once();
+
+	return report();
+}
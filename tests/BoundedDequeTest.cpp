@@ -0,0 +1,366 @@
+// : g++ -std=c++20 -g -fsanitize=address,undefined tests/BoundedDequeTest.cpp -o bounded_test
+// : bounded_test;   -   
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../BoundedDeque.h"
+#include "Check.h"
+
+// HELPERS
+
+//    throw_after- ;  ,
+//  spill 
+struct Throwing_Copy
+{
+	static inline int throw_after = -1;
+
+	int value = 0;
+
+	Throwing_Copy() = default;
+	explicit Throwing_Copy(int v) : value(v) {}
+	Throwing_Copy(const Throwing_Copy& other) : value(other.value)
+	{
+		if (throw_after >= 0 && throw_after-- == 0)
+			throw std::runtime_error("copy failed");
+	}
+	Throwing_Copy& operator=(const Throwing_Copy&) = default;
+};
+
+// SPILL
+
+//    Deque       
+static void test_spill_throw_leaves_no_duplicates()
+{
+	BoundedDeque<Throwing_Copy, 4, Bounded_Overflow_Grow> deque;
+	for (int i = 0; i < 4; ++i)
+		deque.push_back(Throwing_Copy(i));
+
+	Throwing_Copy::throw_after = 3; //       
+	bool thrown = false;
+	try
+	{
+		deque.push_back(Throwing_Copy(4));
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	Throwing_Copy::throw_after = -1;
+	CHECK(thrown);
+	CHECK(!deque.spilled() && deque.size() == 4);
+
+	deque.push_back(Throwing_Copy(4));
+	CHECK(deque.spilled() && deque.size() == 5);
+	for (int i = 0; i < 5; ++i)
+		CHECK(deque[i].value == i);
+}
+
+// API
+
+template <typename _Bounded>
+bool same_as(const _Bounded& deque, const std::deque<typename _Bounded::value_type>& expected)
+{
+	if (deque.size() != expected.size())
+		return false;
+	for (std::size_t i = 0; i < expected.size(); ++i)
+		if (deque[i] != expected[i])
+			return false;
+	return true;
+}
+
+// insert/erase/emplace  std::deque; Grow  ,   std::deque
+static void test_grow_matches_std_deque()
+{
+	BoundedDeque<std::string, 8, Bounded_Overflow_Grow> deque;
+	std::deque<std::string> expected;
+	std::mt19937 rng(13);
+
+	for (int step = 0; step < 4000; ++step)
+	{
+		std::string value = std::to_string(step);
+		std::size_t size = expected.size();
+		std::size_t index = size == 0 ? 0 : rng() % (size + 1);
+
+		switch (rng() % 8)
+		{
+		case 0:
+			deque.push_back(value);
+			expected.push_back(value);
+			break;
+		case 1:
+			deque.push_front(value);
+			expected.push_front(value);
+			break;
+		case 2:
+			deque.insert(deque.begin() + index, value);
+			expected.insert(expected.begin() + index, value);
+			break;
+		case 3:
+			deque.emplace(deque.begin() + index, 2, 'x');
+			expected.emplace(expected.begin() + index, 2, 'x');
+			break;
+		case 4:
+			if (index < size)
+			{
+				deque.erase(deque.begin() + index);
+				expected.erase(expected.begin() + index);
+			}
+			break;
+		case 5:
+		{
+			std::size_t last = index + rng() % (size - index + 1);
+			deque.erase(deque.begin() + index, deque.begin() + last);
+			expected.erase(expected.begin() + index, expected.begin() + last);
+			break;
+		}
+		case 6:
+			if (size > 0)
+			{
+				deque.pop_front();
+				expected.pop_front();
+			}
+			break;
+		default:
+		{
+			std::vector<std::string> values{ value, value + "a", value + "b" };
+			deque.insert(deque.begin() + index, values.begin(), values.end());
+			expected.insert(expected.begin() + index, values.begin(), values.end());
+			break;
+		}
+		}
+
+		if (!same_as(deque, expected))
+		{
+			CHECK(same_as(deque, expected));
+			return;
+		}
+	}
+}
+
+//     :     
+static void test_ring_matches_std_deque()
+{
+	BoundedDeque<std::string, 16> deque;
+	std::deque<std::string> expected;
+	std::mt19937 rng(21);
+
+	for (int step = 0; step < 4000; ++step)
+	{
+		std::string value = std::to_string(step);
+		std::size_t size = expected.size();
+		std::size_t index = size == 0 ? 0 : rng() % (size + 1);
+
+		if (rng() % 2 == 0 && size < 16)
+		{
+			deque.insert(deque.begin() + index, value);
+			expected.insert(expected.begin() + index, value);
+		}
+		else
+		{
+			std::size_t last = index + rng() % (std::min<std::size_t>(size - index, 3) + 1);
+			deque.erase(deque.begin() + index, deque.begin() + last);
+			expected.erase(expected.begin() + index, expected.begin() + last);
+		}
+
+		if (!same_as(deque, expected))
+		{
+			CHECK(same_as(deque, expected));
+			return;
+		}
+	}
+}
+
+// OVERFLOW POLICIES
+
+static void test_push_overflow_policies()
+{
+	BoundedDeque<int, 4> reject{ 1, 2, 3, 4 };
+	CHECK(reject.full() && !reject.try_push_back(5) && !reject.try_push_front(0));
+	bool thrown = false;
+	try
+	{
+		reject.push_back(5);
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown && reject == (BoundedDeque<int, 4>{ 1, 2, 3, 4 }));
+
+	// push_back  , push_front - 
+	BoundedDeque<int, 4, Bounded_Overflow_Overwrite> overwrite{ 1, 2, 3, 4 };
+	overwrite.push_back(5);
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 2, 3, 4, 5 }));
+	overwrite.push_front(0);
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 0, 2, 3, 4 }));
+
+	// Grow   Deque    , 
+	BoundedDeque<int, 4, Bounded_Overflow_Grow> grow{ 1, 2, 3, 4 };
+	grow.push_front(0);
+	grow.push_back(5);
+	CHECK(grow.spilled() && grow.size() == 6 && grow.front() == 0 && grow.back() == 5);
+	while (!grow.empty())
+		grow.pop_front();
+	CHECK(!grow.spilled());
+	grow.push_back(7);
+	CHECK(!grow.spilled() && grow.size() == 1 && grow.front() == 7);
+}
+
+static void test_reject_and_overwrite_insert()
+{
+	BoundedDeque<int, 4> reject{ 1, 2, 3 };
+	reject.insert(reject.begin() + 1, 9);
+	CHECK(reject == (BoundedDeque<int, 4>{ 1, 9, 2, 3 }));
+
+	bool thrown = false;
+	try
+	{
+		reject.insert(reject.begin() + 2, 8);
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown && reject.size() == 4);
+
+	//   ,    
+	BoundedDeque<int, 4, Bounded_Overflow_Overwrite> overwrite{ 1, 2, 3, 4 };
+	overwrite.insert(overwrite.begin() + 2, 9);
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 2, 9, 3, 4 }));
+	overwrite.insert(overwrite.end(), 5);
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 9, 3, 4, 5 }));
+}
+
+// RANGE INSERT
+
+static void test_range_insert()
+{
+	BoundedDeque<int, 8> ring{ 1, 2, 3, 4 };
+	std::vector<int> values{ 7, 8, 9 };
+	auto it = ring.insert(ring.begin() + 1, values.begin(), values.end());
+	CHECK(it == ring.begin() + 1);
+	CHECK(ring == (BoundedDeque<int, 8>{ 1, 7, 8, 9, 2, 3, 4 }));
+
+	//  :     
+	bool thrown = false;
+	try
+	{
+		ring.insert(ring.begin() + 2, values.begin(), values.end());
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown && ring == (BoundedDeque<int, 8>{ 1, 7, 8, 9, 2, 3, 4 }));
+
+	//     
+	std::istringstream input("5 6");
+	thrown = false;
+	try
+	{
+		ring.insert(ring.begin(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown && ring.size() == 7);
+	std::istringstream one("5");
+	ring.insert(ring.begin(), std::istream_iterator<int>(one), std::istream_iterator<int>());
+	CHECK(ring.size() == 8 && ring[0] == 5 && ring[1] == 1);
+
+	//   ,      
+	BoundedDeque<int, 4, Bounded_Overflow_Overwrite> overwrite{ 1, 2, 3, 4 };
+	std::vector<int> two{ 8, 9 };
+	overwrite.insert(overwrite.begin() + 3, two.begin(), two.end());
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 3, 8, 9, 4 }));
+	std::vector<int> three{ 5, 6, 7 };
+	overwrite.insert(overwrite.begin() + 1, three.begin(), three.end());
+	CHECK(overwrite == (BoundedDeque<int, 4, Bounded_Overflow_Overwrite>{ 7, 8, 9, 4 }));
+}
+
+//       
+static void test_range_insert_throw()
+{
+	std::vector<Throwing_Copy> values{ Throwing_Copy(7), Throwing_Copy(8), Throwing_Copy(9) };
+	BoundedDeque<Throwing_Copy, 8> ring;
+	for (int i = 0; i < 3; ++i)
+		ring.emplace_back(i);
+
+	Throwing_Copy::throw_after = 1;
+	bool thrown = false;
+	try
+	{
+		ring.insert(ring.begin() + 1, values.begin(), values.end());
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	Throwing_Copy::throw_after = -1;
+	CHECK(thrown && ring.size() == 3);
+	CHECK(ring[0].value == 0 && ring[1].value == 1 && ring[2].value == 2);
+}
+
+static_assert(std::is_nothrow_move_constructible_v<BoundedDeque<std::string, 8>>);
+static_assert(std::is_nothrow_move_assignable_v<BoundedDeque<std::string, 8, Bounded_Overflow_Grow>>);
+static_assert(!std::is_nothrow_move_constructible_v<BoundedDeque<Throwing_Copy, 8>>);
+
+static void test_resize_assign_swap()
+{
+	BoundedDeque<int, 8> a;
+	a.resize(3, 7);
+	CHECK(a.size() == 3 && a[0] == 7 && a[2] == 7);
+	a.resize(5);
+	CHECK(a.size() == 5 && a[4] == 0);
+	a.resize(1);
+	CHECK(a.size() == 1 && a[0] == 7);
+
+	bool thrown = false;
+	try
+	{
+		a.resize(9);
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown && a.size() == 1);
+
+	a.assign({ 1, 2, 3 });
+	BoundedDeque<int, 8> b;
+	b.assign(4, 5);
+	a.swap(b);
+	CHECK(a == (BoundedDeque<int, 8>{ 5, 5, 5, 5 }));
+	CHECK(b == (BoundedDeque<int, 8>{ 1, 2, 3 }));
+	CHECK(a != b);
+
+	BoundedDeque<int, 2, Bounded_Overflow_Grow> grow{ 1 };
+	grow.resize(6, 4);
+	CHECK(grow.spilled() && grow.size() == 6 && grow.back() == 4);
+	BoundedDeque<int, 2, Bounded_Overflow_Grow> ring{ 8 };
+	grow.swap(ring);
+	CHECK(!grow.spilled() && grow.size() == 1 && ring.spilled() && ring.size() == 6);
+}
+
+int main()
+{
+	test_spill_throw_leaves_no_duplicates();
+	test_grow_matches_std_deque();
+	test_ring_matches_std_deque();
+	test_push_overflow_policies();
+	test_reject_and_overwrite_insert();
+	test_range_insert();
+	test_range_insert_throw();
+	test_resize_assign_swap();
+
+	return report();
+}
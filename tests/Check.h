@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdio>
+
+//    :     ,
+//     main
+
+inline int g_failures = 0;
+
+#define CHECK(cond) \
+	do \
+	{ \
+		if (!(cond)) \
+		{ \
+			std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+			++g_failures; \
+		} \
+	} while (false)
+
+inline int report()
+{
+	if (g_failures == 0)
+		std::printf("all tests passed\n");
+	return g_failures;
+}
@@ -0,0 +1,174 @@
+// : g++ -std=c++20 -O1 -g -pthread -fsanitize=thread tests/ConcurrentQueueTest.cpp -o concurrent_test
+// : concurrent_test;   -   
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ConcurrentQueue.h"
+#include "Check.h"
+
+// HELPERS
+
+//   SSO,       
+struct Boxed
+{
+	std::string text;
+
+	Boxed() = default;
+	Boxed(long value) : text(std::to_string(value) + "-padding-past-sso") {}
+	explicit operator long() const { return std::stol(text); }
+};
+
+//    
+struct Poisoned
+{
+	long value;
+
+	Poisoned(long v) : value(v) {}
+	Poisoned(const Poisoned& other) : value(other.value)
+	{
+		if (value < 0)
+			throw std::runtime_error("poisoned copy");
+	}
+	Poisoned(Poisoned&&) noexcept = default;
+	Poisoned& operator=(const Poisoned&) = default;
+	Poisoned& operator=(Poisoned&&) noexcept = default;
+};
+
+// EXCEPTIONS
+
+//       hazard pointer:  
+// MAX_HAZARDS,        
+static void test_throw_releases_hazard()
+{
+	ConcurrentQueue<Poisoned, std::allocator<Poisoned>, Deque_Block_Elements<4>> queue;
+	std::vector<Poisoned> batch;
+	batch.push_back(Poisoned(1));
+	batch.push_back(Poisoned(-1));
+
+	int thrown = 0;
+	for (int i = 0; i < 300; ++i)
+	{
+		try
+		{
+			queue.try_push_bulk(batch.begin(), batch.size());
+		}
+		catch (const std::runtime_error&)
+		{
+			++thrown;
+		}
+	}
+	CHECK(thrown == 300);
+
+	queue.try_push(Poisoned(2));
+	std::vector<Poisoned> out;
+	out.reserve(301);
+	while (queue.try_pop_bulk(std::back_inserter(out), 64) > 0)
+		;
+	CHECK(out.size() == 301 && out.back().value == 2);
+	CHECK(queue.empty());
+}
+
+// STRESS
+
+//       ,    
+//     
+template <typename _Queue>
+static void run_mpmc(int producers, int consumers, long per_producer, bool bulk)
+{
+	using value_type = typename _Queue::value_type;
+
+	_Queue queue;
+	std::vector<std::atomic<int>> seen(producers * per_producer);
+	std::atomic<long> received{ 0 };
+	std::atomic<bool> fifo_per_producer{ true };
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+		threads.emplace_back([&, p]
+		{
+			std::vector<value_type> batch;
+			for (long i = 0; i < per_producer;)
+			{
+				if (!bulk)
+				{
+					queue.try_push(value_type(p * per_producer + i));
+					++i;
+					continue;
+				}
+
+				batch.clear();
+				long count = std::min<long>(per_producer - i, 1 + i % 37);
+				for (long j = 0; j < count; ++j)
+					batch.push_back(value_type(p * per_producer + i + j));
+				queue.try_push_bulk(batch.begin(), count);
+				i += count;
+			}
+		});
+
+	for (int c = 0; c < consumers; ++c)
+		threads.emplace_back([&]
+		{
+			std::vector<long> last(producers, -1);
+			value_type values[16];
+			while (received.load() < producers * per_producer)
+			{
+				std::size_t count = bulk ? queue.try_pop_bulk(values, 16) : queue.try_pop(values[0]);
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					long value = static_cast<long>(values[i]);
+					long producer = value / per_producer;
+					if (value <= last[producer])
+						fifo_per_producer = false;
+					last[producer] = value;
+					++seen[value];
+					++received;
+				}
+			}
+		});
+
+	for (auto& thread : threads)
+		thread.join();
+
+	bool exactly_once = true;
+	for (auto& hits : seen)
+		exactly_once = exactly_once && hits == 1;
+	CHECK(exactly_once);
+	CHECK(fifo_per_producer);
+	CHECK(queue.empty());
+}
+
+static void test_stress()
+{
+	run_mpmc<ConcurrentQueue<long>>(4, 4, 50000, false);
+	run_mpmc<ConcurrentQueue<long>>(4, 4, 50000, true);
+	run_mpmc<ConcurrentQueue<long, std::allocator<long>, Deque_Block_Elements<4>>>(3, 3, 30000, true);
+	run_mpmc<ConcurrentQueue<Boxed, std::allocator<Boxed>, Deque_Block_Elements<8>>>(3, 3, 10000, false);
+	run_mpmc<ConcurrentQueue<Boxed, std::allocator<Boxed>, Deque_Block_Elements<8>>>(3, 3, 10000, true);
+}
+
+//        
+static void test_destroy_non_empty()
+{
+	ConcurrentQueue<std::string> queue;
+	for (int i = 0; i < 300; ++i)
+		queue.try_push(std::string(40, 'x'));
+	std::string value;
+	CHECK(queue.try_pop(value) && value.size() == 40);
+	CHECK(!queue.empty());
+}
+
+int main()
+{
+	test_destroy_non_empty();
+	test_throw_releases_hazard();
+	test_stress();
+
+	return report();
+}
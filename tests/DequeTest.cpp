@@ -0,0 +1,1071 @@
+// : g++ -std=c++20 -g -fsanitize=address,undefined tests/DequeTest.cpp -o deque_test
+// : deque_test;   -   
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Deque.h"
+#include "Check.h"
+
+// HELPERS
+
+struct Alloc_Counters
+{
+	long allocations = 0;
+	long deallocations = 0;
+	long block_allocations = 0;  //  
+	long block_deallocations = 0;
+	long live_bytes = 0;
+};
+
+//   ; _Propagate    propagate_on_*
+template <typename _Ty, bool _Propagate = false>
+struct Counting_Allocator
+{
+	using value_type = _Ty;
+	using propagate_on_container_copy_assignment = std::bool_constant<_Propagate>;
+	using propagate_on_container_move_assignment = std::bool_constant<_Propagate>;
+	using propagate_on_container_swap = std::bool_constant<_Propagate>;
+	using is_always_equal = std::false_type;
+
+	Alloc_Counters* counters;
+
+	explicit Counting_Allocator(Alloc_Counters* c) noexcept : counters(c) {}
+	template <typename _Other>
+	Counting_Allocator(const Counting_Allocator<_Other, _Propagate>& other) noexcept : counters(other.counters) {}
+
+	template <typename _Other>
+	struct rebind { using other = Counting_Allocator<_Other, _Propagate>; };
+
+	_Ty* allocate(std::size_t n)
+	{
+		++counters->allocations;
+		if constexpr (!std::is_pointer_v<_Ty>)
+			++counters->block_allocations;
+		counters->live_bytes += long(n * sizeof(_Ty));
+		return static_cast<_Ty*>(::operator new(n * sizeof(_Ty)));
+	}
+	void deallocate(_Ty* ptr, std::size_t n) noexcept
+	{
+		++counters->deallocations;
+		if constexpr (!std::is_pointer_v<_Ty>)
+			++counters->block_deallocations;
+		counters->live_bytes -= long(n * sizeof(_Ty));
+		::operator delete(ptr);
+	}
+
+	template <typename _Other>
+	bool operator==(const Counting_Allocator<_Other, _Propagate>& other) const noexcept { return counters == other.counters; }
+};
+
+template <typename _Deque>
+bool same_as(const _Deque& deque, const std::deque<typename _Deque::value_type>& expected)
+{
+	if (deque.size() != expected.size())
+		return false;
+	for (std::size_t i = 0; i < expected.size(); ++i)
+		if (deque[i] != expected[i])
+			return false;
+	return std::equal(deque.begin(), deque.end(), expected.begin());
+}
+
+// RANDOMIZED
+
+//    std::deque   ,   ,
+// auto-shrink   ;  -   
+template <typename _Deque>
+static void run_against_std_deque(_Deque deque, unsigned seed)
+{
+	std::deque<std::string> expected;
+	std::mt19937 rng(seed);
+
+	for (int step = 0; step < 20000; ++step)
+	{
+		std::string value = std::to_string(step) + "-padding-past-sso";
+		std::size_t size = expected.size();
+		std::size_t index = size == 0 ? 0 : rng() % (size + 1);
+		std::size_t count = size == 0 ? 0 : rng() % (size + 1);
+
+		switch (rng() % 20)
+		{
+		case 0: case 1: case 2:
+			deque.push_back(value);
+			expected.push_back(value);
+			break;
+		case 3: case 4: case 5:
+			deque.push_front(value);
+			expected.push_front(value);
+			break;
+		case 6:
+			if (size > 0)
+			{
+				deque.pop_back();
+				expected.pop_back();
+			}
+			break;
+		case 7:
+			if (size > 0)
+			{
+				deque.unchecked_pop_back();
+				expected.pop_back();
+			}
+			break;
+		case 8:
+			if (size > 0)
+			{
+				deque.pop_front();
+				expected.pop_front();
+			}
+			break;
+		case 9:
+			if (size > 0)
+			{
+				deque.unchecked_pop_front();
+				expected.pop_front();
+			}
+			break;
+		case 10:
+			deque.insert(deque.begin() + index, value);
+			expected.insert(expected.begin() + index, value);
+			break;
+		case 11:
+			if (index < size && rng() % 2)
+			{
+				deque.erase(deque.begin() + index);
+				expected.erase(expected.begin() + index);
+			}
+			else if (index < size)
+			{
+				std::size_t last = index + rng() % (std::min<std::size_t>(size - index, 20) + 1);
+				deque.erase(deque.begin() + index, deque.begin() + last);
+				expected.erase(expected.begin() + index, expected.begin() + last);
+			}
+			break;
+		case 12:
+			count = std::min<std::size_t>(count, 40);
+			if (rng() % 2)
+			{
+				deque.pop_back_n(count);
+				expected.erase(expected.end() - count, expected.end());
+			}
+			else
+			{
+				deque.pop_front_n(count);
+				expected.erase(expected.begin(), expected.begin() + count);
+			}
+			break;
+		case 13:
+		{
+			std::vector<std::string> drained;
+			deque.drain_front(count, std::back_inserter(drained));
+			CHECK(std::equal(drained.begin(), drained.end(), expected.begin()));
+			expected.erase(expected.begin(), expected.begin() + count);
+			break;
+		}
+		case 14:
+		{
+			std::vector<std::string> values(rng() % 30, value);
+			if (rng() % 2)
+			{
+				deque.append(values.begin(), values.end());
+				expected.insert(expected.end(), values.begin(), values.end());
+			}
+			else
+			{
+				deque.prepend(values.begin(), values.end());
+				expected.insert(expected.begin(), values.begin(), values.end());
+			}
+			break;
+		}
+		case 16:
+			if (rng() % 2)
+				deque.reserve_back(rng() % 50);
+			else
+				deque.reserve_front(rng() % 50);
+			break;
+		case 17:
+			if (rng() % 4 == 0)
+				deque.shrink_to_fit();
+			else
+				deque.set_auto_shrink(rng() % 3);
+			break;
+		case 18:
+			deque.set_spare_block_limit(rng() % 4);
+			break;
+		default:
+			if (rng() % 50 == 0)
+			{
+				deque.clear();
+				expected.clear();
+			}
+			else if (rng() % 10 == 0)
+			{
+				_Deque copy(deque);
+				_Deque moved(std::move(copy));
+				moved.swap(deque);
+				CHECK(copy.empty());
+			}
+			break;
+		}
+
+		if (!same_as(deque, expected))
+		{
+			std::printf("diverged at step %d (seed %u)\n", step, seed);
+			CHECK(same_as(deque, expected));
+			return;
+		}
+	}
+}
+
+static void test_randomized_against_std_deque()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<std::string>;
+		run_against_std_deque(Deque<std::string, Alloc, Deque_Block_Elements<8>>(Alloc(&counters)), 1);
+		run_against_std_deque(Deque<std::string, Alloc, Deque_Block_Elements<4>, 3>(Alloc(&counters)), 2);
+		run_against_std_deque(Deque<std::string, Alloc>(Alloc(&counters)), 3);
+	}
+	CHECK(counters.live_bytes == 0 && counters.allocations == counters.deallocations);
+}
+
+// ALLOCATOR
+
+static void test_allocator_propagation()
+{
+	Alloc_Counters a, b;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc> x{ Alloc(&a) };
+		Deque<int, Alloc> y{ Alloc(&b) };
+		for (int i = 0; i < 1000; ++i)
+			x.push_back(i);
+
+		//  propagate   ,  
+		y = x;
+		CHECK(y.get_allocator().counters == &b && y == x);
+		y = std::move(x);
+		CHECK(y.get_allocator().counters == &b && y.size() == 1000 && y[999] == 999);
+
+		Deque<int, Alloc> z(std::move(y), Alloc(&a));
+		CHECK(z.get_allocator().counters == &a && z.size() == 1000 && z[0] == 0);
+	}
+	CHECK(a.live_bytes == 0 && b.live_bytes == 0);
+
+	Alloc_Counters c, d;
+	{
+		using Alloc = Counting_Allocator<int, true>;
+		Deque<int, Alloc> x{ Alloc(&c) };
+		Deque<int, Alloc> y{ Alloc(&d) };
+		for (int i = 0; i < 1000; ++i)
+			x.push_back(i);
+
+		y = x;
+		CHECK(y.get_allocator().counters == &c);
+		Deque<int, Alloc> w{ Alloc(&d) };
+		w.push_back(5);
+		w.swap(y);
+		CHECK(w.get_allocator().counters == &c && w.size() == 1000 && y.size() == 1);
+		y = std::move(w);
+		CHECK(y.get_allocator().counters == &c && y.size() == 1000);
+	}
+	CHECK(c.live_bytes == 0 && d.live_bytes == 0);
+
+	std::pmr::monotonic_buffer_resource arena;
+	Deque<int, std::pmr::polymorphic_allocator<int>> pmr(&arena);
+	for (int i = 0; i < 5000; ++i)
+		pmr.push_front(i);
+	CHECK(pmr.front() == 4999 && pmr.back() == 0);
+}
+
+// BLOCK SIZE
+
+static void test_block_size_policy()
+{
+	static_assert(Deque<char>::block_size() == 4096);
+	static_assert(Deque<int>::block_size() == 1024);
+	static_assert(Deque<char[3000]>::block_size() == 1);
+	static_assert(Deque<char[24], std::allocator<char[24]>, Deque_Block_Bytes<1024>>::block_size() == 32);
+	static_assert(Deque<int, std::allocator<int>, Deque_Block_Elements<16>>::block_size() == 16);
+
+	//        
+	Deque<int, std::allocator<int>, Deque_Block_Elements<4>> deque;
+	for (int i = 0; i < 30; ++i)
+		deque.push_back(i);
+	for (int i = 1; i <= 10; ++i)
+		deque.push_front(-i);
+
+	auto last = deque.end() - 1;
+	for (int step = 0; step < 40; ++step)
+	{
+		CHECK(*(last - step) == 29 - step);
+		CHECK(deque.begin() + (39 - step) == last - step);
+		CHECK((last - step) - deque.begin() == 39 - step);
+	}
+	CHECK(deque.end() - deque.begin() == 40);
+}
+
+// TRIVIAL COPY
+
+//         
+static void test_trivial_copy_and_fill()
+{
+	using Small_Deque = Deque<int, std::allocator<int>, Deque_Block_Elements<8>>;
+
+	for (int front = 0; front < 20; front += 3)
+	{
+		Small_Deque source;
+		std::deque<int> expected;
+		for (int i = 0; i < 50; ++i)
+		{
+			source.push_back(i);
+			expected.push_back(i);
+		}
+		for (int i = 0; i < front; ++i)
+		{
+			source.push_front(-i);
+			expected.push_front(-i);
+		}
+
+		Small_Deque copy(source);
+		CHECK(same_as(copy, expected));
+
+		Small_Deque target;
+		for (int i = 0; i < 5; ++i)
+			target.push_front(i);
+		target = source;
+		CHECK(same_as(target, expected));
+
+		Small_Deque larger(100, 7);
+		larger = source;
+		CHECK(same_as(larger, expected));
+
+		target.assign(front + 13, 9);
+		CHECK(same_as(target, std::deque<int>(front + 13, 9)));
+
+		target.resize(front + 40, 4);
+		std::deque<int> filled(front + 13, 9);
+		filled.resize(front + 40, 4);
+		CHECK(same_as(target, filled));
+	}
+}
+
+// BULK APPEND
+
+//       
+static void test_append_prepend_ranges()
+{
+	Deque<int, std::allocator<int>, Deque_Block_Elements<8>> deque{ 1, 2, 3 };
+
+	std::istringstream back_input("4 5 6 7 8 9 10 11 12");
+	deque.append(std::istream_iterator<int>(back_input), std::istream_iterator<int>());
+	std::istringstream front_input("-8 -7 -6 -5 -4 -3 -2 -1 0");
+	deque.prepend(std::istream_iterator<int>(front_input), std::istream_iterator<int>());
+	CHECK(deque.size() == 21 && deque.front() == -8 && deque.back() == 12);
+	for (std::size_t i = 0; i < deque.size(); ++i)
+		CHECK(deque[i] == int(i) - 8);
+
+	std::vector<int> middle{ 100, 101, 102 };
+	deque.insert(deque.begin() + 10, middle.begin(), middle.end());
+	CHECK(deque.size() == 24 && deque[9] == 1 && deque[10] == 100 && deque[12] == 102 && deque[13] == 2);
+	deque.insert(deque.begin() + 2, middle.begin(), middle.end());
+	deque.insert(deque.end() - 2, middle.begin(), middle.end());
+	CHECK(deque.size() == 30 && deque[1] == -7 && deque[2] == 100 && deque[5] == -6);
+	CHECK(deque[24] == 10 && deque[25] == 100 && deque[27] == 102 && deque[28] == 11);
+	for (int i = 0; i < 3; ++i)
+	{
+		deque.erase(deque.end() - 3);
+		deque.erase(deque.begin() + 2);
+	}
+
+	Deque<int, std::allocator<int>, Deque_Block_Elements<8>> copy;
+	copy.append_range(deque);
+	copy.prepend_range(middle);
+	CHECK(copy.size() == 27 && copy[0] == 100 && copy[3] == -8 && copy.back() == 12);
+}
+
+// MOVE ONLY
+
+static void test_move_only_elements()
+{
+	Deque<std::unique_ptr<int>, std::allocator<std::unique_ptr<int>>, Deque_Block_Elements<4>> deque(6);
+	CHECK(deque.size() == 6 && deque[5] == nullptr);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		deque.push_back(std::make_unique<int>(i));
+		deque.push_front(std::make_unique<int>(-i));
+	}
+	deque.emplace(deque.begin() + 8, std::make_unique<int>(100));
+	deque.insert(deque.begin() + 3, std::make_unique<int>(200));
+	CHECK(deque.size() == 28 && *deque[3] == 200 && *deque[9] == 100);
+
+	deque.erase(deque.begin() + 3);
+	CHECK(deque.size() == 27 && *deque[8] == 100 && *deque.front() == -9 && *deque.back() == 9);
+
+	deque.resize(30);
+	CHECK(deque.size() == 30 && deque.back() == nullptr);
+}
+
+// ERASE IF
+
+static void test_erase_and_erase_if()
+{
+	Deque<int, std::allocator<int>, Deque_Block_Elements<8>> deque;
+	std::deque<int> expected;
+	for (int i = 0; i < 100; ++i)
+	{
+		deque.push_back(i % 7);
+		expected.push_back(i % 7);
+	}
+
+	CHECK(erase(deque, 3) == std::erase(expected, 3));
+	CHECK(erase_if(deque, [](int x) { return x % 2 == 0; }) == std::erase_if(expected, [](int x) { return x % 2 == 0; }));
+	CHECK(same_as(deque, expected));
+	CHECK(erase(deque, 42) == 0);
+
+	auto it = deque.erase(deque.begin() + 5, deque.end() - 5);
+	CHECK(deque.size() == 10 && it == deque.end() - 5);
+	CHECK(deque.erase(deque.begin(), deque.begin()) == deque.begin());
+	deque.erase(deque.begin(), deque.end());
+	CHECK(deque.empty());
+}
+
+// SEGMENTS
+
+static void test_segmented_algorithms()
+{
+	using Small_Deque = Deque<int, std::allocator<int>, Deque_Block_Elements<8>>;
+	Small_Deque deque;
+	for (int i = 0; i < 30; ++i)
+		deque.push_back(i);
+	for (int i = 1; i <= 5; ++i)
+		deque.push_front(-i);
+
+	std::size_t total = 0;
+	int next = -5;
+	for (std::span<const int> segment : std::as_const(deque).segments())
+	{
+		CHECK(!segment.empty() && segment.size() <= Small_Deque::block_size());
+		for (int value : segment)
+			CHECK(value == next++);
+		total += segment.size();
+	}
+	CHECK(total == deque.size());
+
+	std::vector<int> copied;
+	segmented_copy(deque, std::back_inserter(copied));
+	CHECK(copied.size() == 35 && copied.front() == -5 && copied.back() == 29);
+
+	int sum = 0;
+	segmented_for_each(deque, [&sum](int value) { sum += value; });
+	CHECK(sum == segmented_accumulate(deque, 0) && sum == 435 - 15);
+	CHECK(segmented_count(deque, 7) == 1 && *segmented_find(deque, 7) == 7);
+	CHECK(segmented_find(deque, 100) == deque.end());
+
+	//       
+	Deque<int, std::allocator<int>, Deque_Block_Elements<4>> other;
+	other.append_range(copied);
+	CHECK(segmented_equal(deque, other));
+	other.back() = 0;
+	CHECK(!segmented_equal(deque, other));
+
+	segmented_fill(deque, 3);
+	CHECK(segmented_count(deque, 3) == deque.size());
+}
+
+// SPARE BLOCKS
+
+// FIFO-     
+static void test_spare_block_reuse()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>> queue{ Alloc(&counters) };
+		for (int i = 0; i < 1000; ++i)
+			queue.push_back(i);
+		for (int i = 0; i < 100; ++i)
+		{
+			queue.push_back(i);
+			queue.pop_front();
+		}
+
+		long before = counters.block_allocations;
+		for (int i = 0; i < 100000; ++i)
+		{
+			queue.push_back(i);
+			queue.pop_front();
+		}
+		CHECK(counters.block_allocations == before);
+		CHECK(queue.spare_blocks() <= queue.spare_block_limit());
+
+		queue.set_spare_block_limit(0);
+		CHECK(queue.spare_blocks() == 0);
+		queue.set_spare_block_limit(8);
+		while (!queue.empty())
+			queue.pop_front();
+		CHECK(queue.spare_blocks() > 0);
+		queue.shrink_to_fit();
+		CHECK(queue.spare_blocks() == 0);
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+// MAP
+
+static void test_lazy_map()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc> empty{ Alloc(&counters) };
+		Deque<int, Alloc> copy(empty);
+		Deque<int, Alloc> moved(std::move(copy));
+		empty.clear();
+		empty.shrink_to_fit();
+		CHECK(empty.capacity() == 0 && empty.begin() == empty.end());
+		CHECK(counters.allocations == 0);
+
+		moved.push_front(1);
+		moved.push_back(2);
+		CHECK(moved.size() == 2 && moved[0] == 1 && moved[1] == 2);
+
+		moved.clear();
+		moved.shrink_to_fit();
+		CHECK(counters.live_bytes == 0);
+	}
+	static_assert(std::is_nothrow_default_constructible_v<Deque<int>>);
+}
+
+// FIFO-     ,    
+static void test_fifo_keeps_map()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>> queue{ Alloc(&counters) };
+		for (int i = 0; i < 100; ++i)
+			queue.push_back(i);
+		for (int i = 0; i < 1000; ++i)
+		{
+			queue.push_back(i);
+			queue.pop_front();
+		}
+
+		long maps_before = counters.allocations - counters.block_allocations;
+		for (int i = 0; i < 100000; ++i)
+		{
+			queue.push_back(i);
+			queue.pop_front();
+		}
+		CHECK(counters.allocations - counters.block_allocations == maps_before);
+		CHECK(queue.size() == 100 && queue.front() == 99900);
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+// RESERVE
+
+static void test_reserve()
+{
+	Alloc_Counters counters;
+	using Alloc = Counting_Allocator<int>;
+	Deque<int, Alloc, Deque_Block_Elements<16>> deque{ Alloc(&counters) };
+
+	deque.reserve_back(100);
+	deque.reserve_front(50);
+	CHECK(deque.capacity_back() >= 100 && deque.capacity_front() >= 50);
+
+	long before = counters.allocations;
+	for (int i = 0; i < 100; ++i)
+		deque.push_back(i);
+	for (int i = 0; i < 50; ++i)
+		deque.push_front(-i);
+	CHECK(counters.allocations == before);
+	CHECK(deque.size() == 150 && deque.capacity() >= deque.size());
+}
+
+//   pop_back, erase, clear  auto-shrink,   shrink_to_fit
+static void test_reserve_kept_until_shrink()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>> deque{ Alloc(&counters) };
+		deque.set_spare_block_limit(0);
+		deque.set_auto_shrink(1);
+		deque.push_back(0);
+		deque.reserve_back(200);
+		deque.reserve_front(100);
+
+		for (int round = 0; round < 3; ++round)
+		{
+			long before = counters.block_allocations;
+			for (int i = 0; i < 199; ++i)
+				deque.push_back(i);
+			while (deque.size() > 101)
+				deque.pop_back();
+			deque.erase(deque.begin() + 1, deque.end());
+			CHECK(counters.block_allocations == before);
+			CHECK(deque.capacity_back() >= 199 && deque.capacity_front() >= 100);
+		}
+
+		deque.clear();
+		CHECK(deque.capacity_back() >= 200);
+
+		deque.shrink_to_fit();
+		CHECK(counters.live_bytes == 0 && deque.capacity() == 0);
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+// CLEAR
+
+// clear()          
+static void test_clear_does_not_allocate()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc> deque{ Alloc(&counters) };
+		for (int i = 0; i < 5000; ++i)
+			deque.push_front(i);
+
+		long before = counters.allocations;
+		deque.clear();
+		CHECK(counters.allocations == before && deque.empty());
+
+		deque.push_back(1);
+		deque.push_front(0);
+		CHECK(deque.size() == 2 && deque.front() == 0 && deque.back() == 1);
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+// AUTO SHRINK
+
+//         ,   
+static void test_auto_shrink_empty_with_offset()
+{
+	Deque<int, std::allocator<int>, Deque_Block_Elements<16>> deque;
+	deque.set_spare_block_limit(0);
+	deque.set_auto_shrink(1);
+	for (int i = 0; i < 40; ++i)
+		deque.push_back(i);
+	deque.pop_front();
+	while (!deque.empty())
+		deque.pop_back();
+	CHECK(deque.empty());
+
+	deque.push_back(7);
+	deque.push_front(6);
+	CHECK(deque.size() == 2 && deque.front() == 6 && deque.back() == 7);
+}
+
+// BULK POP
+
+// pop_back_n, pop_front_n  drain_front     
+static void test_bulk_pop_to_empty_with_auto_shrink()
+{
+	using Small_Deque = Deque<int, std::allocator<int>, Deque_Block_Elements<16>>;
+
+	for (int mode = 0; mode < 3; ++mode)
+	{
+		for (int skip = 0; skip < 40; skip += 7)
+		{
+			Small_Deque deque;
+			deque.set_spare_block_limit(0);
+			deque.set_auto_shrink(1);
+			for (int i = 0; i < 100; ++i)
+				deque.push_back(i);
+			deque.pop_front_n(skip);
+
+			std::vector<int> drained;
+			if (mode == 0)
+				deque.pop_back_n(deque.size());
+			else if (mode == 1)
+				deque.pop_front_n(deque.size());
+			else
+				deque.drain_front(deque.size(), std::back_inserter(drained));
+			CHECK(deque.empty());
+			if (mode == 2)
+				CHECK(drained.size() == std::size_t(100 - skip) && drained.front() == skip && drained.back() == 99);
+
+			for (int i = 0; i < 40; ++i)
+			{
+				deque.push_back(i);
+				deque.push_front(-i);
+			}
+			CHECK(deque.size() == 80 && deque.front() == -39 && deque.back() == 39);
+		}
+	}
+}
+
+//     
+struct Throwing_Move
+{
+	static inline int throw_on = -1;
+	int value = 0;
+
+	Throwing_Move(int v) : value(v) {}
+	Throwing_Move(const Throwing_Move&) = default;
+	Throwing_Move& operator=(const Throwing_Move&) = default;
+	Throwing_Move(Throwing_Move&& other) : value(other.value)
+	{
+		if (value == throw_on)
+			throw std::runtime_error("move failed");
+	}
+	Throwing_Move& operator=(Throwing_Move&& other)
+	{
+		if (other.value == throw_on)
+			throw std::runtime_error("move failed");
+		value = other.value;
+		return *this;
+	}
+};
+
+//    :    ,   
+static void test_drain_front_throw_keeps_current_block()
+{
+	Deque<Throwing_Move, std::allocator<Throwing_Move>, Deque_Block_Elements<8>> deque;
+	for (int i = 0; i < 30; ++i)
+		deque.push_back(Throwing_Move(i));
+
+	std::vector<Throwing_Move> drained;
+	Throwing_Move::throw_on = 11;
+	bool thrown = false;
+	try
+	{
+		deque.drain_front(20, std::back_inserter(drained));
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	Throwing_Move::throw_on = -1;
+
+	CHECK(thrown);
+	CHECK(drained.size() == 11 && drained.back().value == 10);
+	CHECK(deque.size() == 22 && deque[3].value == 11 && deque.back().value == 29);
+}
+
+// UNCHECKED POP
+
+//  pop       
+static void test_unchecked_pops()
+{
+	using Small_Deque = Deque<int, std::allocator<int>, Deque_Block_Elements<4>>;
+	static_assert(noexcept(std::declval<Small_Deque&>().unchecked_pop_back()));
+	static_assert(noexcept(std::declval<Small_Deque&>().unchecked_pop_front()));
+
+	Small_Deque deque;
+	for (int i = 0; i < 20; ++i)
+		deque.push_back(i);
+	for (int i = 0; i < 7; ++i)
+		deque.unchecked_pop_front();
+	for (int i = 0; i < 6; ++i)
+		deque.unchecked_pop_back();
+	CHECK(deque.size() == 7 && deque.front() == 7 && deque.back() == 13);
+
+	while (!deque.empty())
+		deque.unchecked_pop_back();
+	deque.push_front(1);
+	CHECK(deque.size() == 1 && deque.back() == 1);
+
+	bool thrown = false;
+	deque.unchecked_pop_front();
+	try
+	{
+		deque.pop_front();
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown);
+}
+
+// INLINE
+
+static void test_inline_spill_and_return()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>, 8> deque{ Alloc(&counters) };
+		for (int i = 0; i < 8; ++i)
+			deque.push_back(i);
+		CHECK(counters.allocations == 0);
+
+		deque.push_front(-1);
+		CHECK(counters.allocations > 0);
+		CHECK(deque.size() == 9 && deque.front() == -1 && deque.back() == 7);
+
+		for (int i = 0; i < 5; ++i)
+			deque.pop_back();
+		deque.shrink_to_fit();
+		CHECK(counters.live_bytes == 0);
+		CHECK(deque.size() == 4 && deque[0] == -1 && deque[3] == 2);
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+//           
+static void test_inline_capacity()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>, 8> deque{ Alloc(&counters) };
+		CHECK(deque.capacity() == 8 && deque.capacity_front() == 8 && deque.capacity_back() == 8);
+
+		deque.push_back(1);
+		deque.push_back(2);
+		CHECK(deque.capacity() == 8 && deque.capacity_front() == 6 && deque.capacity_back() == 6);
+
+		for (int i = 0; i < 6; ++i)
+			deque.push_front(-i);
+		CHECK(counters.allocations == 0);
+		CHECK(deque.capacity_front() == 0 && deque.capacity_back() == 0);
+
+		deque.push_back(3);
+		CHECK(counters.allocations > 0 && deque.capacity() >= deque.size());
+	}
+	CHECK(counters.live_bytes == 0);
+}
+
+//     :  ,    
+static void test_inline_larger_than_policy_block()
+{
+	using Big_Inline = SmallDeque<long long, 600>;
+	static_assert(Big_Inline::block_size() > 600);
+
+	Big_Inline deque;
+	for (int i = 0; i < 2000; ++i)
+		deque.push_back(i);
+	for (int i = 0; i < 100; ++i)
+		deque.push_front(-i);
+	CHECK(deque.size() == 2100 && deque.front() == -99 && deque.back() == 1999);
+
+	deque.erase(deque.begin() + 10, deque.end() - 10);
+	deque.shrink_to_fit();
+	CHECK(deque.size() == 20 && deque[9] == -90 && deque[10] == 1990);
+
+	SmallDeque<int, 1024> exact;
+	static_assert(decltype(exact)::block_size() == 2048);
+	exact.push_back(1);
+	CHECK(exact.back() == 1);
+}
+
+// CURSOR
+
+//     ,  operator[],    
+template <typename _Deque>
+static void check_cursor_matches_index(_Deque& deque, unsigned seed)
+{
+	auto cursor = deque.cursor();
+	for (std::size_t i = 0; i < deque.size(); ++i)
+	{
+		if (&cursor[i] != &deque[i])
+		{
+			CHECK(&cursor[i] == &deque[i]);
+			return;
+		}
+	}
+	for (std::size_t i = deque.size(); i-- > 0;)
+	{
+		if (&cursor[i] != &deque[i])
+		{
+			CHECK(&cursor[i] == &deque[i]);
+			return;
+		}
+	}
+
+	std::mt19937 rng(seed);
+	const auto& cdeque = deque;
+	auto ccursor = cdeque.cursor();
+	for (int step = 0; step < 1000; ++step)
+	{
+		std::size_t index = rng() % deque.size();
+		if (&ccursor[index] != &cdeque[index])
+		{
+			CHECK(&ccursor[index] == &cdeque[index]);
+			return;
+		}
+	}
+}
+
+static void test_cursor_matches_index()
+{
+	Deque<int, std::allocator<int>, Deque_Block_Elements<8>> blocks;
+	for (int i = 0; i < 100; ++i)
+		blocks.push_back(i);
+	for (int i = 0; i < 37; ++i)
+		blocks.push_front(-i);
+	check_cursor_matches_index(blocks, 1);
+
+	SmallDeque<int, 6, std::allocator<int>, Deque_Block_Elements<8>> small{ 1, 2, 3 };
+	check_cursor_matches_index(small, 2);
+	for (int i = 0; i < 20; ++i)
+		small.push_front(i);
+	check_cursor_matches_index(small, 3);
+}
+
+// STATS
+
+using Stats_Deque = Deque<int, Counting_Allocator<int>, Deque_Block_Elements<16>, 0, Deque_Stats>;
+
+//       -  ,   
+static bool stats_balanced(const Alloc_Counters& counters, std::initializer_list<const Stats_Deque*> deques)
+{
+	long owned = 0;
+	for (const Stats_Deque* deque : deques)
+		owned += long(deque->stats().block_allocations - deque->stats().block_frees);
+	return owned == counters.block_allocations - counters.block_deallocations;
+}
+
+static void test_stats_follow_storage()
+{
+	Alloc_Counters counters;
+	Stats_Deque a{ Counting_Allocator<int>(&counters) };
+	for (int i = 0; i < 200; ++i)
+		a.push_back(i);
+	CHECK(a.stats().peak_size == 200);
+	CHECK(long(a.stats().bytes_reserved) == counters.live_bytes);
+
+	Stats_Deque b(std::move(a));
+	CHECK(b.stats().peak_size == 200 && a.stats().peak_size == 0);
+	CHECK(a.stats().block_allocations == 0 && long(b.stats().bytes_reserved) == counters.live_bytes);
+
+	Stats_Deque c{ Counting_Allocator<int>(&counters) };
+	c.push_back(1);
+	c.swap(b);
+	CHECK(c.stats().peak_size == 200 && b.stats().peak_size == 1);
+	CHECK(stats_balanced(counters, { &a, &b, &c }));
+
+	a = std::move(c);
+	CHECK(a.stats().peak_size == 200 && c.stats().peak_size == 0);
+	CHECK(stats_balanced(counters, { &a, &b, &c }));
+
+	//   ,      
+	for (int i = 0; i < 190; ++i)
+		a.pop_front();
+	std::size_t maps_before = a.stats().map_allocations;
+	a.shrink_to_fit();
+	CHECK(a.stats().map_allocations == maps_before + 1);
+	CHECK(stats_balanced(counters, { &a, &b, &c }));
+
+	a.clear();
+	a.shrink_to_fit();
+	CHECK(a.stats().block_allocations == a.stats().block_frees);
+	CHECK(stats_balanced(counters, { &a, &b, &c }));
+}
+
+// ,      ,    
+static void test_stats_inline_shrink()
+{
+	Deque<int, std::allocator<int>, Deque_Block_Elements<16>, 8, Deque_Stats> deque;
+	for (int i = 0; i < 40; ++i)
+		deque.push_back(i);
+	for (int i = 0; i < 36; ++i)
+		deque.pop_back();
+	deque.shrink_to_fit();
+
+	Deque_Stats stats = deque.stats();
+	CHECK(stats.block_allocations > 0 && stats.block_allocations == stats.block_frees);
+	CHECK(stats.peak_size == 40 && stats.bytes_reserved == 0);
+	CHECK(deque.size() == 4 && deque.back() == 3);
+}
+
+static_assert(sizeof(Deque<int>) == sizeof(Deque<int, std::allocator<int>, Deque_Block_Bytes<4096>, 0, Deque_No_Stats>));
+
+// MEMORY USAGE
+
+template <typename _Deque>
+static void check_memory_usage(const _Deque& deque)
+{
+	std::size_t live = 0;
+	deque.for_each_block([&](const int*, std::size_t capacity, std::size_t first, std::size_t last)
+	{
+		CHECK(first <= last && last <= capacity);
+		live += last - first;
+	});
+	auto usage = deque.memory_usage();
+	CHECK(live == deque.size() && usage.live_bytes == deque.size() * sizeof(int));
+	CHECK(usage.live_bytes + usage.front_slack_bytes + usage.back_slack_bytes == deque.capacity() * sizeof(int));
+}
+
+static void test_memory_usage_matches_blocks()
+{
+	Alloc_Counters counters;
+	{
+		using Alloc = Counting_Allocator<int>;
+		Deque<int, Alloc, Deque_Block_Elements<16>> deque{ Alloc(&counters) };
+		for (int i = 0; i < 100; ++i)
+			deque.push_back(i);
+		for (int i = 0; i < 37; ++i)
+			deque.push_front(i);
+		check_memory_usage(deque);
+
+		for (int i = 0; i < 60; ++i)
+			deque.pop_back();
+		check_memory_usage(deque);
+		auto usage = deque.memory_usage();
+		CHECK(long(usage.map_bytes + usage.block_bytes) == counters.live_bytes);
+		CHECK(usage.spare_bytes <= usage.block_bytes && usage.inline_bytes == 0);
+	}
+
+	//        
+	SmallDeque<int, 8, std::allocator<int>, Deque_Block_Elements<16>> small;
+	check_memory_usage(small);
+	small.push_back(1);
+	small.push_front(0);
+	check_memory_usage(small);
+	CHECK(small.memory_usage().inline_bytes == 8 * sizeof(int) && small.memory_usage().block_bytes == 0);
+	for (int i = 0; i < 10; ++i)
+		small.push_back(i);
+	check_memory_usage(small);
+}
+
+int main()
+{
+	test_randomized_against_std_deque();
+	test_allocator_propagation();
+	test_block_size_policy();
+	test_trivial_copy_and_fill();
+	test_append_prepend_ranges();
+	test_move_only_elements();
+	test_erase_and_erase_if();
+	test_segmented_algorithms();
+	test_spare_block_reuse();
+	test_lazy_map();
+	test_fifo_keeps_map();
+	test_reserve();
+	test_reserve_kept_until_shrink();
+	test_clear_does_not_allocate();
+	test_auto_shrink_empty_with_offset();
+	test_bulk_pop_to_empty_with_auto_shrink();
+	test_drain_front_throw_keeps_current_block();
+	test_unchecked_pops();
+	test_inline_spill_and_return();
+	test_inline_capacity();
+	test_inline_larger_than_policy_block();
+	test_cursor_matches_index();
+	test_stats_follow_storage();
+	test_stats_inline_shrink();
+	test_memory_usage_matches_blocks();
+
+	return report();
+}
@@ -0,0 +1,129 @@
+// : g++ -std=c++20 -O1 -g -pthread -fsanitize=thread tests/SpscDequeTest.cpp -o spsc_test
+//      -fsanitize=address,undefined  thread
+// : spsc_test;   -   
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../SpscDeque.h"
+#include "Check.h"
+
+// HELPERS
+
+//  ,  throw_next  
+struct Throwing_Copy
+{
+	static inline bool throw_next = false;
+
+	int value = 0;
+
+	Throwing_Copy() = default;
+	explicit Throwing_Copy(int v) : value(v) {}
+	Throwing_Copy(const Throwing_Copy& other) : value(other.value)
+	{
+		if (throw_next)
+			throw std::runtime_error("copy failed");
+	}
+	Throwing_Copy& operator=(const Throwing_Copy&) = default;
+};
+
+// EXCEPTIONS
+
+//           
+static void test_throw_on_block_boundary()
+{
+	SpscDeque<Throwing_Copy, std::allocator<Throwing_Copy>, Deque_Block_Elements<4>> queue;
+
+	for (int i = 0; i < 4; ++i)
+		queue.push_back(Throwing_Copy(i));
+
+	Throwing_Copy next(4);
+	for (int attempt = 0; attempt < 3; ++attempt)
+	{
+		Throwing_Copy::throw_next = true;
+		bool thrown = false;
+		try
+		{
+			queue.push_back(next);
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		CHECK(thrown);
+		CHECK(queue.size() == 4);
+	}
+	Throwing_Copy::throw_next = false;
+
+	for (int i = 4; i < 10; ++i)
+		queue.push_back(Throwing_Copy(i));
+
+	std::vector<int> popped;
+	Throwing_Copy out;
+	while (queue.try_pop_front(out))
+		popped.push_back(out.value);
+
+	CHECK(popped.size() == 10);
+	for (std::size_t i = 0; i < popped.size(); ++i)
+		CHECK(popped[i] == int(i));
+}
+
+// STRESS
+
+//     ;  
+//        
+template <typename _Queue, typename _Make>
+static void run_producer_consumer(long count, _Make make)
+{
+	_Queue queue;
+
+	std::thread producer([&]
+	{
+		for (long i = 0; i < count; ++i)
+		{
+			queue.push_back(make(i));
+			if (i % 1000 == 0)
+				std::this_thread::yield();
+		}
+	});
+
+	bool in_order = true;
+	std::thread consumer([&]
+	{
+		typename _Queue::value_type value{};
+		for (long i = 0; i < count;)
+		{
+			if (queue.try_pop_front(value))
+			{
+				in_order = in_order && value == make(i);
+				++i;
+			}
+		}
+	});
+
+	producer.join();
+	consumer.join();
+	CHECK(in_order);
+	CHECK(queue.empty());
+}
+
+static void test_stress_in_order()
+{
+	auto make_long = [](long i) { return i; };
+	auto make_string = [](long i) { return std::to_string(i) + std::string(20, 'x'); };
+
+	run_producer_consumer<SpscDeque<long>>(200000, make_long);
+	run_producer_consumer<SpscDeque<long, std::allocator<long>, Deque_Block_Elements<4>>>(200000, make_long);
+	run_producer_consumer<SpscDeque<std::string, std::allocator<std::string>, Deque_Block_Elements<8>>>(50000, make_string);
+}
+
+int main()
+{
+	test_throw_on_block_boundary();
+	test_stress_in_order();
+
+	return report();
+}
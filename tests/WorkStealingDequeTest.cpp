@@ -0,0 +1,104 @@
+// : g++ -std=c++20 -O1 -g -pthread -fsanitize=thread tests/WorkStealingDequeTest.cpp -o stealing_test
+// : stealing_test;   -   
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "../WorkStealingDeque.h"
+#include "Check.h"
+
+// SINGLE THREAD
+
+//       ,    
+static void test_owner_and_thief_ends()
+{
+	WorkStealingDeque<int, std::allocator<int>, Deque_Block_Elements<2>> deque;
+	for (int i = 0; i < 1000; ++i)
+		deque.push_back(i);
+
+	int value = 0;
+	bool in_order = true;
+	for (int i = 0; i < 500; ++i)
+		in_order = in_order && deque.try_steal_front(value) && value == i;
+
+	//   ,    
+	for (int i = 1000; i < 3000; ++i)
+		deque.push_back(i);
+	for (int i = 2999; i >= 500; --i)
+		in_order = in_order && deque.try_pop_back(value) && value == i;
+
+	CHECK(in_order);
+	CHECK(!deque.try_pop_back(value) && !deque.try_steal_front(value));
+	CHECK(deque.empty());
+}
+
+// STRESS
+
+//      :   
+template <typename _BlockPolicy>
+static void run_steal_stress(long count, int thieves)
+{
+	WorkStealingDeque<long, std::allocator<long>, _BlockPolicy> deque;
+	std::vector<std::atomic<int>> seen(count);
+	std::atomic<bool> done{ false };
+	std::atomic<long> taken{ 0 };
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < thieves; ++i)
+		threads.emplace_back([&]
+		{
+			long value = 0;
+			while (!done.load())
+			{
+				if (deque.try_steal_front(value))
+				{
+					++seen[value];
+					++taken;
+				}
+			}
+		});
+
+	long value = 0;
+	unsigned seed = 1;
+	for (long i = 0; i < count; ++i)
+	{
+		deque.push_back(i);
+		seed = seed * 1103515245 + 12345;
+		if ((seed >> 16) % 3 == 0 && deque.try_pop_back(value))
+		{
+			++seen[value];
+			++taken;
+		}
+	}
+	while (deque.try_pop_back(value))
+	{
+		++seen[value];
+		++taken;
+	}
+
+	done = true;
+	for (auto& thread : threads)
+		thread.join();
+
+	bool exactly_once = true;
+	for (auto& hits : seen)
+		exactly_once = exactly_once && hits == 1;
+	CHECK(taken == count);
+	CHECK(exactly_once);
+}
+
+static void test_stress_exactly_once()
+{
+	run_steal_stress<Deque_Block_Elements<4>>(100000, 3);
+	run_steal_stress<Deque_Block_Bytes<4096>>(200000, 3);
+}
+
+int main()
+{
+	test_owner_and_thief_ends();
+	test_stress_exactly_once();
+
+	return report();
+}
@@ -0,0 +1,23 @@
+#!/bin/sh
+#     :   ASan/UBSan,
+#    TSan.       tests/.
+set -e
+
+cd "$(dirname "$0")"
+CXX=${CXX:-g++}
+OUT=${OUT:-/tmp/deque_tests}
+mkdir -p "$OUT"
+
+for test in DequeTest BoundedDequeTest SpscDequeTest WorkStealingDequeTest ConcurrentQueueTest BlockingQueueTest
+do
+	echo "== $test (address,undefined)"
+	$CXX -std=c++20 -O1 -g -pthread -fsanitize=address,undefined $test.cpp -o "$OUT/$test"
+	"$OUT/$test"
+done
+
+for test in SpscDequeTest WorkStealingDequeTest ConcurrentQueueTest BlockingQueueTest
+do
+	echo "== $test (thread)"
+	$CXX -std=c++20 -O1 -g -pthread -fsanitize=thread -Wno-tsan $test.cpp -o "$OUT/${test}_tsan"
+	TSAN_OPTIONS=halt_on_error=1 "$OUT/${test}_tsan"
+done